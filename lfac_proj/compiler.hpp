@@ -1,25 +1,127 @@
 #include <iostream>     // std::cout, std::cerr
 #include <string>       // std::string
+#include <string_view>  // std::string_view (chei pentru pool-ul de simboluri)
 #include <vector>       // (optional, daca vrei sa folosesti vectori dinamici)
+#include <deque>        // std::deque (adrese stabile pentru textul simbolurilor)
+#include <unordered_map>// std::unordered_map
+#include <sstream>      // std::ostringstream (raportul --prune)
+#include <fstream>      // std::ifstream / std::ofstream (interfetele modulelor)
+#include <filesystem>   // caile modulelor importate
+#include <chrono>       // timpul de incarcare al unei interfete
+#include <cstdio>       // std::rename, std::remove
+#include <cstdint>      // std::uint32_t
+#include <charconv>     // std::to_chars (conversiile numerice)
 #include <cstdlib>      // std::exit, EXIT_FAILURE
 #include <cmath>        // pentru fmod sau fabs (daca e nevoie)
+#include <algorithm>    // std::min_element / std::max_element (analiza de intervale)
 #include <memory>       // std::unique_ptr / std::shared_ptr (optional, pentru un management mai elegant)
+#include <mutex>        // std::mutex (prima eroare dintr-un parallel for)
+#include <sys/resource.h> // getrlimit (cat loc are stiva pt. apeluri recursive)
+
+#include "rtstring.hpp" // RtString: valorile de tip `string` (SSO + rope in heap-ul cu GC)
+#include "profiler.hpp" // Profiler: modul --profile
+#include "output.hpp"   // ProgramOutput: iesirea lui Print / TypeOf
+#include "scheduler.hpp"// Scheduler: task-urile pornite cu spawn
+#include "parallel.hpp" // ParallelRange: iteratiile unui parallel for, impartite pe fire
 
 constexpr int LENMAX = 1024;
 constexpr int DMAX   = 16;
+constexpr int ARRAYMAX = 1 << 20; // dimensiunea maxima a unui array (valorile stau intr-un singur text)
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                POOL DE SIMBOLURI (string interning)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Fiecare identificator / tip / domeniu primeste un id pe 32 de biti, o singura
+// data (din lexer). Mai departe comparam doar id-uri, nu std::string-uri.
+using SymbolId = std::uint32_t;
+
+// Simboluri rezervate, mereu pe aceleasi pozitii in pool
+enum : SymbolId
+{
+    SYM_GLOBAL,
+    SYM_MAIN,
+    SYM_INT,
+    SYM_FLOAT,
+    SYM_BOOL,
+    SYM_CHAR,
+    SYM_STRING,
+    SYM_VOID
+};
+
+struct SymbolPool
+{
+    std::deque<std::string> names;                        // textul, indexat dupa id
+    std::unordered_map<std::string_view, SymbolId> index; // text -> id (view-uri in names)
+
+    SymbolPool()
+    {
+        for (const char* s : {"global", "main", "int", "float", "bool", "char", "string", "void"})
+            intern(s);
+    }
+
+    SymbolId intern(std::string_view text)
+    {
+        auto it = index.find(text);
+        if (it != index.end())
+            return it->second;
+        names.emplace_back(text);
+        SymbolId id = static_cast<SymbolId>(names.size() - 1);
+        index.emplace(names.back(), id);
+        return id;
+    }
+
+    const std::string& name(SymbolId id) const
+    {
+        return names[id];
+    }
+};
+SymbolPool symbols;
+
+// Apelata din lexer pentru ID si TYPE
+SymbolId internSymbol(const char* text, int len)
+{
+    return symbols.intern(std::string_view(text, len));
+}
+
+// Enum modern (enum class) pentru tipurile de noduri AST
+enum class Category
+{
+    NUMBER_FLOAT,
+    NUMBER_INT,
+    NUMBER_BOOL,
+    CHAR,
+    STRING,
+    OPERATOR,
+    IDENTIFIER,
+    CALL,
+    OTHER,
+    CHANNEL     // c.send(x) / c.recv(v) / c.close(); dupa OTHER, ca interfetele sa nu se schimbe
+};
+
+// Tipul unei variabile / functii: categoria de baza + dimensiunea (in loc de "int[10]")
+struct TypeInfo
+{
+    Category base = Category::OTHER; // pt. clase: OTHER
+    SymbolId name = SYM_VOID;        // simbolul tipului: "int", "numere" etc.
+    int      dim  = 0;               // 0 = scalar, altfel dimensiunea array-ului
+};
 
-// Variabile globale pentru domenii (folosim std::string in loc de char[])
-std::string domain         = "global";
-std::string functionDomain = "global";
-std::string paramTemp      = "-";
-std::string args;
-std::string lvalue;
-std::string identif, indexStr;
+// Variabile globale pentru domenii (id-uri din pool in loc de std::string)
+SymbolId domain         = SYM_GLOBAL;
+SymbolId functionDomain = SYM_GLOBAL;
+std::string paramTemp   = "-";
+bool inBody             = false; // suntem in corpul unei functii / al lui main
+int  currentModule      = -1;    // modulul (import) parsat acum; -1 = fisierul principal
+
+struct AST;
+struct Stmt;
 
 // Structura „clasa” + array
 struct Clasa
 {
-    std::string name;
+    SymbolId name;
+    int      module = -1; // modulul care a declarat-o (-1 = fisierul principal)
 };
 Clasa classes[LENMAX];
 int classNumber = 0;
@@ -27,11 +129,13 @@ int classNumber = 0;
 // Structura pentru variabile
 struct VarSymbol
 {
-    std::string type;   // ex: "int" sau "int[10]"
-    std::string name;   // numele variabilei
+    TypeInfo    type;   // ex: int, sau int cu dim = 10
+    SymbolId    name;   // numele variabilei
     std::string value;  // valoarea curenta (ex: "10" sau "0 0 0 ..." pt. array)
-    std::string domain; // ex: "global", "nume_clasa", "nume_functie", etc.
+    RtString    text;   // valoarea curenta pt. variabilele scalare de tip string
+    SymbolId    domain; // ex: "global", "nume_clasa", "nume_functie", etc.
     bool isConst;
+    int  module = -1;   // modulul care a declarat-o (-1 = fisierul principal)
 };
 VarSymbol vars[LENMAX];
 int varsNumber = 0;
@@ -39,26 +143,20 @@ int varsNumber = 0;
 // Structura pentru functii
 struct FuncSymbol
 {
-    std::string returnType;
-    std::string name;
+    TypeInfo    returnType;
+    SymbolId    name;
     std::string paramList; // ex: "int, bool"
-    std::string domain;    // la ce clasa sau context apartine
+    SymbolId    domain;    // la ce clasa sau context apartine
+    std::vector<VarSymbol*> params; // variabilele parametrilor, in ordine
+    std::vector<Stmt*>      body;   // instructiunile, executate la fiecare apel
+    int                     module = -1;
 };
 FuncSymbol func[LENMAX];
 int funcNumber = 0;
+int funcVersion = 0;   // creste la orice schimbare a functiilor sau a corpurilor (invalideaza frameVars)
+std::vector<VarSymbol*> paramVars; // parametrii functiei care se parseaza acum
 
-// Enum modern (enum class) pentru tipurile de noduri AST
-enum class Category
-{
-    NUMBER_FLOAT,
-    NUMBER_INT,
-    NUMBER_BOOL,
-    CHAR,
-    STRING,
-    OPERATOR,
-    IDENTIFIER,
-    OTHER
-};
+std::vector<Stmt*> mainBody;       // instructiunile din main, executate dupa parsare
 
 // Structura pentru nodurile din arbore (AST)
 struct AST
@@ -68,6 +166,71 @@ struct AST
     Category    treeType; // tipul dedus dupa analiza
     AST*        left  = nullptr; 
     AST*        right = nullptr;
+    RtString    text;               // pt. literali STRING: valoarea, construita o singura data
+    SymbolId    sym   = SYM_GLOBAL; // pt. IDENTIFIER: variabila
+    VarSymbol*  var   = nullptr;    // pt. IDENTIFIER: variabila, rezolvata la parsare
+    AST*        index = nullptr;    // pt. IDENTIFIER: expresia indexului (nullptr = scalar)
+    bool        indexSafe = false;  // pt. IDENTIFIER: indexul e dovedit in [0, dim) la compilare
+    VarSymbol*  object = nullptr;   // pt. obj.x si obj.f(): obiectul (doar pt. --prune)
+    int         funcIndex = -1;     // pt. CALL: functia apelata (index in func)
+    std::vector<AST*> args;         // pt. CALL: argumentele
+};
+
+// Tinta unei atribuiri: variabila + index (nullptr daca nu e element de array)
+struct LValue
+{
+    SymbolId   name  = SYM_GLOBAL;
+    VarSymbol* var   = nullptr;
+    AST*       index = nullptr;
+    bool       indexSafe = false;   // ca la AST: fara verificare la rulare
+    VarSymbol* object = nullptr;    // pt. obj.x = ...
+};
+LValue lvalue;
+
+// Instructiunile din corpul functiilor si din main (executate dupa parsare)
+enum class StmtKind
+{
+    DECL,       // declaratie locala: (re)initializeaza variabila
+    ASSIGN,
+    EXPR,       // ex: apel de functie
+    PRINT,
+    TYPEOF,
+    IF,
+    WHILE,
+    DO_WHILE,
+    FOR,
+    RETURN,
+    SPAWN,      // spawn f(...): expr e apelul
+    PARALLEL_FOR // ca FOR, plus clauzele din parallel
+};
+
+// O variabila din reduce(...): op e '+', '*', '<' (min) sau '>' (max)
+struct Reduction
+{
+    char       op;
+    VarSymbol* var;
+};
+
+// parallel(static|dynamic, chunk) for (...) reduce(...)
+struct ParallelSpec
+{
+    bool                   dynamic = false;
+    int                    chunk   = 0;   // 0 = implicit (static: un bloc per fir, dynamic: 1)
+    std::vector<Reduction> reductions;
+};
+ParallelSpec parallelSpec;   // clauzele buclei parsate acum (ca lvalue)
+
+struct Stmt
+{
+    StmtKind   kind;
+    int        line;
+    AST*       expr   = nullptr;   // valoarea / conditia
+    LValue     target;             // pt. DECL / ASSIGN
+    Stmt*      init   = nullptr;   // pt. FOR
+    Stmt*      step   = nullptr;   // pt. FOR
+    ParallelSpec parallel;         // pt. PARALLEL_FOR
+    std::vector<Stmt*> body;
+    std::vector<Stmt*> elseBody;   // pt. IF
 };
 
 // Structura pentru rezultatul evaluarii unui nod
@@ -75,21 +238,66 @@ struct ResultAST
 {
     std::string resultStr; 
     Category    treeType;
+    RtString    text;      // valoarea pt. treeType == STRING (resultStr ramane gol)
 };
 
+// Valoarea ca text, indiferent de tip (pt. afisare / stocare in array-uri)
+std::string resultText(const ResultAST& res)
+{
+    return (res.treeType == Category::STRING) ? res.text.str() : res.resultStr;
+}
+
+std::string varValueText(const VarSymbol& v)
+{
+    return (v.type.base == Category::STRING && v.type.dim == 0) ? v.text.str() : v.value;
+}
+
+// Pune valoarea in variabila: sirurile raman RtString (fara copiere), restul text
+void storeValue(VarSymbol& v, const ResultAST& value)
+{
+    if (v.type.base == Category::STRING && v.type.dim == 0)
+        v.text = (value.treeType == Category::STRING) ? value.text : RtString(value.resultStr);
+    else
+        v.value = resultText(value);
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//                OPRIREA LA EROARE
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Orice eroare (de compilare sau de executie) ajunge aici, dupa afisarea mesajului.
+// Compilatorul iese din program; REPL-ul si harness-urile de fuzzing seteaza
+// throwOnError, prind exceptia si continua cu urmatorul input.
+struct CompilationAborted {};
+bool throwOnError = false;
+std::vector<std::string> importTrail; // modulele (import) in curs de parsare, pt. mesaje
+
+[[noreturn]] void abortCompilation()
+{
+    for (auto it = importTrail.rbegin(); it != importTrail.rend(); ++it)
+        std::cerr << "  in module " << *it << "\n";
+    if (throwOnError)
+        throw CompilationAborted();
+    std::exit(EXIT_FAILURE);
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //                FUNCTII DE CONVERSIE
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 std::string itoaCustom(int value)
 {
-    return std::to_string(value);
+    char digits[16];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    return std::string(digits, res.ptr);
 }
 
 std::string ftoaCustom(float value)
 {
-    // std::to_string(value) de obicei produce ~6 cifre dupa virgula
-    return std::to_string(value);
+    // 6 cifre dupa virgula, ca std::to_string ("%f"); FLT_MAX are 39 de cifre
+    char digits[64];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6);
+    return std::string(digits, res.ptr);
 }
 
 // Converteste "true"/"false" in 1/0
@@ -98,15 +306,35 @@ int atob(const std::string& valueStr)
     return (valueStr == "true") ? 1 : 0;
 }
 
-// Stabilim tipul (enum) pe baza stringului (ex: "int" -> NUMBER_INT)
-Category convertStringToEnum(const std::string& type)
+// Stabilim categoria pe baza simbolului tipului (ex: SYM_INT -> NUMBER_INT)
+Category categoryOfSymbol(SymbolId type)
+{
+    switch (type)
+    {
+        case SYM_INT:    return Category::NUMBER_INT;
+        case SYM_FLOAT:  return Category::NUMBER_FLOAT;
+        case SYM_BOOL:   return Category::NUMBER_BOOL;
+        case SYM_CHAR:   return Category::CHAR;
+        case SYM_STRING: return Category::STRING;
+        default:         return Category::OTHER;
+    }
+}
+
+// Tipul scalar corespunzator unui simbol (tip de baza sau nume de clasa)
+TypeInfo typeFromSymbol(SymbolId type)
 {
-    if (type.find("int")    != std::string::npos) return Category::NUMBER_INT;
-    if (type.find("float")  != std::string::npos) return Category::NUMBER_FLOAT;
-    if (type.find("bool")   != std::string::npos) return Category::NUMBER_BOOL;
-    if (type.find("char")   != std::string::npos) return Category::CHAR;
-    if (type.find("string") != std::string::npos) return Category::STRING;
-    return Category::OTHER;
+    TypeInfo t;
+    t.base = categoryOfSymbol(type);
+    t.name = type;
+    return t;
+}
+
+// Forma text a tipului, doar pentru afisare (ex: "int[10]")
+std::string typeToString(const TypeInfo& type)
+{
+    if (type.dim == 0)
+        return symbols.name(type.name);
+    return symbols.name(type.name) + "[" + std::to_string(type.dim) + "]";
 }
 
 std::string convertEnumToString(Category category)
@@ -132,19 +360,30 @@ int checkSize(const ResultAST& dim, int yylineno)
     if (dim.treeType != Category::NUMBER_INT)
     {
         std::cerr << "[Line " << yylineno << "] Error: Incorrect array dimension.\n";
-        std::exit(EXIT_FAILURE);
+        abortCompilation();
     }
     int dimInt = std::stoi(dim.resultStr);
-    if (dimInt < 1)
+    if (dimInt < 1 || dimInt > ARRAYMAX)
     {
         std::cerr << "[Line " << yylineno << "] Error: Incorrect array dimension.\n";
-        std::exit(EXIT_FAILURE);
+        abortCompilation();
     }
     return dimInt;
 }
 
+// Tabelele de simboluri au dimensiune fixa: inainte de a adauga verificam locul liber
+void checkCapacity(int count, const char* what, int yylineno)
+{
+    if (count >= LENMAX)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Too many " << what
+                  << " (at most " << LENMAX << ").\n";
+        abortCompilation();
+    }
+}
+
 // Verifica daca o clasa a fost definita
-void checkClass(const std::string& name, int yylineno)
+void checkClass(SymbolId name, int yylineno)
 {
     int i = 0;
     for (; i < classNumber; i++)
@@ -154,36 +393,45 @@ void checkClass(const std::string& name, int yylineno)
     }
     if (i == classNumber)
     {
-        std::cerr << "[Line " << yylineno << "] Error: Class " << name << " is not defined\n";
-        std::exit(EXIT_FAILURE);
+        std::cerr << "[Line " << yylineno << "] Error: Class " << symbols.name(name) << " is not defined\n";
+        abortCompilation();
     }
 }
 
+// Transforma rezultatul expresiei dintre [] intr-un index (doar cifre)
+int checkIndex(const ResultAST& index, int yylineno)
+{
+    bool valid = index.treeType == Category::NUMBER_INT && !index.resultStr.empty();
+    for (char c : index.resultStr)
+    {
+        if (c < '0' || c > '9')
+            valid = false;
+    }
+    if (!valid)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Invalid vector index\n";
+        abortCompilation();
+    }
+    return std::stoi(index.resultStr);
+}
+
 // Verifica indexul unui vector (0 <= index < dimensiune)
-void checkValidIndex(const std::string& name, int size, int yylineno)
+void checkValidIndex(const VarSymbol& v, int index, int yylineno)
 {
-    for (int i = 0; i < varsNumber; i++)
+    if (v.type.dim == 0)
+        return;
+    if (!(0 <= index && index < v.type.dim))
     {
-        if (vars[i].name == name)
-        {
-            // tipul e de forma "int[10]" etc.
-            auto pos1 = vars[i].type.find('[');
-            auto pos2 = vars[i].type.find(']');
-            if (pos1 == std::string::npos || pos2 == std::string::npos) 
-                continue;
-            std::string inside = vars[i].type.substr(pos1+1, pos2 - (pos1+1));
-            int dimInt = std::stoi(inside);
-            if (!(0 <= size && size < dimInt))
-            {
-                std::cerr << "[Line " << yylineno << "] Error: Invalid vector index\n";
-                std::exit(EXIT_FAILURE);
-            }
-        }
+        std::cerr << "[Line " << yylineno << "] Error: Invalid vector index\n";
+        abortCompilation();
     }
 }
 
-// Verifica daca paramList coincide cu ce e in args
-void compareParamWithArgs(const std::string& functionName, std::string& localArgs, const std::string& dom, int yylineno)
+// Tipurile argumentelor unui apel, in forma lui paramList (ex: "int, bool" sau "-")
+std::string argsToString(const std::vector<AST*>& callArgs);
+
+// Verifica daca paramList coincide cu ce e in args; intoarce indexul functiei
+int compareParamWithArgs(SymbolId functionName, const std::string& localArgs, SymbolId dom, int yylineno)
 {
     for (int i = 0; i < funcNumber; i++)
     {
@@ -192,17 +440,15 @@ void compareParamWithArgs(const std::string& functionName, std::string& localArg
             if (func[i].paramList != localArgs)
             {
                 std::cerr << "[Line " << yylineno << "] Error: Incorrect parameters passed to the function "
-                          << functionName << ".\n";
-                std::exit(EXIT_FAILURE);
+                          << symbols.name(functionName) << ".\n";
+                abortCompilation();
             }
-            // reset
-            localArgs.clear(); 
-            return;
+            return i;
         }
     }
     std::cerr << "[Line " << yylineno << "] Error: Undefined function " 
-              << functionName << " called.\n";
-    std::exit(EXIT_FAILURE);
+              << symbols.name(functionName) << " called.\n";
+    abortCompilation();
 }
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -210,48 +456,53 @@ void compareParamWithArgs(const std::string& functionName, std::string& localArg
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 // Adaugam o variabila
-void addVar(const std::string& type, const std::string& name, const ResultAST& value, 
-            const std::string& dom, bool isConst, int yylineno)
+void addVar(const TypeInfo& type, SymbolId name, const ResultAST& value, 
+            SymbolId dom, bool isConst, int yylineno)
 {
-    std::string actualDomain = (functionDomain != "global") ? functionDomain : dom;
+    SymbolId actualDomain = (functionDomain != SYM_GLOBAL) ? functionDomain : dom;
 
     for (int i = 0; i < varsNumber; i++)
     {
         if (vars[i].name == name && vars[i].domain == actualDomain)
         {
-            std::cerr << "[ERROR] [Line " << yylineno << "] Variable already declared: " << name << "\n";
-            std::exit(EXIT_FAILURE);
+            std::cerr << "[ERROR] [Line " << yylineno << "] Variable already declared: " << symbols.name(name) << "\n";
+            abortCompilation();
         }
     }
 
+    checkCapacity(varsNumber, "variables", yylineno);
     vars[varsNumber].type    = type;
     vars[varsNumber].name    = name;
-    vars[varsNumber].value   = value.resultStr;
+    storeValue(vars[varsNumber], value);
     vars[varsNumber].domain  = actualDomain;
     vars[varsNumber].isConst = isConst;
+    vars[varsNumber].module  = currentModule;
     varsNumber++;
 
-    std::cout << "[DEBUG] Added variable: " << name << " of type " << type << " in domain " << actualDomain << "\n";
+    std::cout << "[DEBUG] Added variable: " << symbols.name(name) << " of type " << typeToString(type)
+              << " in domain " << symbols.name(actualDomain) << "\n";
 }
 
 
 // Adaugam un array
-void addArray(const std::string& type, const std::string& name, int size, 
-              const std::string& dom, bool isConst, int yylineno)
+void addArray(SymbolId type, SymbolId name, int size, 
+              SymbolId dom, bool isConst, int yylineno)
 {
     for (int i = 0; i < varsNumber; i++)
     {
         if (vars[i].name == name && vars[i].domain == dom)
         {
             std::cerr << "[Line " << yylineno << "] Error: Variable " 
-                      << name << " has already been declared\n";
-            std::exit(EXIT_FAILURE);
+                      << symbols.name(name) << " has already been declared\n";
+            abortCompilation();
         }
     }
 
-    vars[varsNumber].type  = type + "[" + std::to_string(size) + "]";
-    vars[varsNumber].name  = name;
-    std::string initValue  = (type == "bool") ? "false" : "0";
+    checkCapacity(varsNumber, "variables", yylineno);
+    vars[varsNumber].type     = typeFromSymbol(type);
+    vars[varsNumber].type.dim = size;
+    vars[varsNumber].name     = name;
+    std::string initValue     = (type == SYM_BOOL) ? "false" : "0";
 
     // Initializare valorica: ex. "0 0 0 ..." sau "false false ..."
     std::string totalValue;
@@ -265,6 +516,7 @@ void addArray(const std::string& type, const std::string& name, int size,
     vars[varsNumber].value   = totalValue;
     vars[varsNumber].domain  = dom;
     vars[varsNumber].isConst = isConst;
+    vars[varsNumber].module  = currentModule;
     varsNumber++;
 }
 
@@ -280,43 +532,58 @@ void addParameter()
         paramTemp += ", ";
     }
     // ultimul element adaugat la vars
-    paramTemp += vars[varsNumber - 1].type;
+    paramTemp += typeToString(vars[varsNumber - 1].type);
+    paramVars.push_back(&vars[varsNumber - 1]);
 }
 
-// Adaugam functie
-void addFunction(const std::string& returnType, const std::string& name, 
-                 const std::string& dom, int yylineno)
+// Adaugam functie (inainte de corp, ca sa se poata apela pe ea insasi); intoarce indexul
+int addFunction(SymbolId returnType, SymbolId name, SymbolId dom, int yylineno)
 {
     for (int i = 0; i < funcNumber; i++)
     {
         if (func[i].name == name && func[i].domain == dom)
         {
             std::cerr << "[Line " << yylineno << "] Error: Function " 
-                      << name << " has already been declared\n";
-            std::exit(EXIT_FAILURE);
+                      << symbols.name(name) << " has already been declared\n";
+            abortCompilation();
         }
     }
-    func[funcNumber].returnType = returnType;
+    checkCapacity(funcNumber, "functions", yylineno);
+    func[funcNumber].returnType = typeFromSymbol(returnType);
     func[funcNumber].name       = name;
     func[funcNumber].paramList  = paramTemp;
     func[funcNumber].domain     = dom;
+    func[funcNumber].params     = paramVars;
+    func[funcNumber].module     = currentModule;
     paramTemp = "-";
-    funcNumber++;
+    paramVars.clear();
+    funcVersion++;
+    return funcNumber++;
+}
+
+// Corpul functiei, dupa ce a fost parsat
+void setFunctionBody(int funcIndex, std::vector<Stmt*>* body)
+{
+    func[funcIndex].body = std::move(*body);
+    delete body;
+    funcVersion++;
 }
 
 // Adaugam o clasa
-void addClass(const std::string& name, int yylineno)
+void addClass(SymbolId name, int yylineno)
 {
     for (int i = 0; i < classNumber; i++)
     {
         if (classes[i].name == name)
         {
             std::cerr << "[Line " << yylineno << "] Error: Class " 
-                      << name << " has already been defined\n";
-            std::exit(EXIT_FAILURE);
+                      << symbols.name(name) << " has already been defined\n";
+            abortCompilation();
         }
     }
-    classes[classNumber].name = name;
+    checkCapacity(classNumber, "classes", yylineno);
+    classes[classNumber].name   = name;
+    classes[classNumber].module = currentModule;
     classNumber++;
 }
 
@@ -324,36 +591,21 @@ void addClass(const std::string& name, int yylineno)
 //                FUNCTII DE “GET” (accesare)
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-// Extract ID si index dintr-un string de forma "arr[10]"
-void extract_Id_And_Index(const std::string& element, int yylineno)
+// Cauta variabila in domeniul local, apoi in cel al functiei curente, apoi global
+VarSymbol* findVar(SymbolId name)
 {
-    identif.clear();
-    indexStr.clear();
-
-    auto pos1 = element.find('[');
-    auto pos2 = element.find(']');
-
-    if (pos1 == std::string::npos || pos2 == std::string::npos)
-    {
-        std::cerr << "[Line " << yylineno << "] Error: Invalid vector index\n";
-        std::exit(EXIT_FAILURE);
-    }
-    identif  = element.substr(0, pos1);
-    std::string digits = element.substr(pos1 + 1, pos2 - (pos1 + 1));
-
-    // verificam sa fie doar cifre
-    for (char c : digits)
+    for (SymbolId dom : {domain, functionDomain, static_cast<SymbolId>(SYM_GLOBAL)})
     {
-        if (c < '0' || c > '9')
+        for (int i = 0; i < varsNumber; i++)
         {
-            std::cerr << "[Line " << yylineno << "] Error: Invalid vector index\n";
-            std::exit(EXIT_FAILURE);
+            if (vars[i].name == name && vars[i].domain == dom)
+                return &vars[i];
         }
     }
-    indexStr = digits;
+    return nullptr;
 }
 
-std::string getFuncType(const std::string& name)
+TypeInfo getFuncType(SymbolId name)
 {
     for (int i = 0; i < funcNumber; i++)
     {
@@ -362,349 +614,162 @@ std::string getFuncType(const std::string& name)
             return func[i].returnType;
         }
     }
-    return "?";
+    return TypeInfo();
 }
 
-// Returneaza valoarea actuala a variabilei (ex. "10" sau un element dintr-un array)
-std::string getVarValue(const std::string& fullName, int yylineno)
+// index == -1 inseamna toata variabila. Orice alt index negativ, sau un index dovedit
+// valid de analyzeBounds (checkBounds == false) care iese totusi negativ, e o eroare,
+// nu o citire / scriere a intregului array.
+void checkNegativeIndex(int index, bool checkBounds, int yylineno)
 {
-    std::cout << "[DEBUG] Searching for variable: '" << fullName 
-              << "' at line " << yylineno << "\n";
-
-    // Verificam daca variabila este un array
-    bool isArray = (fullName.find('[') != std::string::npos);
-    
-    if (isArray)
+    if (index < -1 || (index == -1 && !checkBounds))
     {
-        std::cout << "[DEBUG] Variable '" << fullName << "' appears to be an array.\n";
-
-        extract_Id_And_Index(fullName, yylineno);
-        int index = std::stoi(indexStr);
-        checkValidIndex(identif, index, yylineno);
-
-        auto getArrayElement = [&](const VarSymbol& v) -> std::string
-        {
-            std::cout << "[DEBUG] Accessing array '" << v.name 
-                      << "' at index " << index << " in domain '" << v.domain << "'\n";
-
-            std::string newValues = v.value;
-            int contor = 0;
-            size_t start = 0;
-            while (true)
-            {
-                auto pos = newValues.find(' ', start);
-                std::string token;
-                if (pos != std::string::npos)
-                    token = newValues.substr(start, pos - start);
-                else
-                    token = newValues.substr(start);
-
-                if (contor == index)
-                {
-                    std::cout << "[DEBUG] Found array element: " << token << "\n";
-                    return token;
-                }
-                contor++;
-                if (pos == std::string::npos)
-                    break;
-                start = pos + 1;
-            }
-
-            std::cerr << "[ERROR] Index " << index << " out of bounds in array '" 
-                      << v.name << "' at line " << yylineno << "\n";
-            return "?";
-        };
+        std::cerr << "[Line " << yylineno << "] Error: Invalid vector index " << index << "\n";
+        abortCompilation();
+    }
+}
 
-        // Cautam array-ul in domeniul local
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == domain)
-            {
-                return getArrayElement(vars[i]);
-            }
-        }
-        // Cautam in domeniul functiei curente
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == functionDomain)
-            {
-                return getArrayElement(vars[i]);
-            }
-        }
-        // Cautam in domeniul global
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == "global")
-            {
-                return getArrayElement(vars[i]);
-            }
-        }
+// Returneaza valoarea actuala a variabilei (ex. "10" sau un element dintr-un array, daca index >= 0).
+// checkBounds == false doar pt. indecsi dovediti valizi de analyzeBounds.
+std::string getVarValue(const VarSymbol& v, int index, int yylineno, bool checkBounds = true)
+{
+    const std::string& text = symbols.name(v.name);
+    checkNegativeIndex(index, checkBounds, yylineno);
+    std::cout << "[DEBUG] Searching for variable: '" << text;
+    if (index >= 0)
+        std::cout << "[" << index << "]";
+    std::cout << "' at line " << yylineno << "\n";
 
-        std::cerr << "[ERROR] Array '" << fullName 
-                  << "' not found in any accessible scope at line " << yylineno << "\n";
-        return "?";
-    }
-    else  // Variabila simpla
+    if (index >= 0)
     {
-        std::cout << "[DEBUG] Variable '" << fullName << "' is NOT an array.\n";
-
-        // Cautam in domeniul local
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == fullName && vars[i].domain == domain)
-            {
-                std::cout << "[DEBUG] Found variable '" << fullName 
-                          << "' in local domain: '" << domain 
-                          << "' with value: " << vars[i].value << "\n";
-                return vars[i].value;
-            }
-        }
+        std::cout << "[DEBUG] Variable '" << text << "[" << index << "]' appears to be an array.\n";
+        if (checkBounds)
+            checkValidIndex(v, index, yylineno);
 
-        // Cautam in domeniul functiei curente
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == fullName && vars[i].domain == functionDomain)
-            {
-                std::cout << "[DEBUG] Found variable '" << fullName 
-                          << "' in function domain: '" << functionDomain 
-                          << "' with value: " << vars[i].value << "\n";
-                return vars[i].value;
-            }
-        }
+        std::cout << "[DEBUG] Accessing array '" << text 
+                  << "' at index " << index << " in domain '" << symbols.name(v.domain) << "'\n";
 
-        // Cautam in domeniul global
-        for (int i = 0; i < varsNumber; i++)
+        const std::string& values = v.value;
+        int contor = 0;
+        size_t start = 0;
+        while (true)
         {
-            if (vars[i].name == fullName && vars[i].domain == "global")
+            auto pos = values.find(' ', start);
+            if (contor == index)
             {
-                std::cout << "[DEBUG] Found variable '" << fullName 
-                          << "' in global domain with value: " << vars[i].value << "\n";
-                return vars[i].value;
+                std::string token = (pos != std::string::npos) ? values.substr(start, pos - start)
+                                                               : values.substr(start);
+                std::cout << "[DEBUG] Found array element: " << token << "\n";
+                return token;
             }
+            contor++;
+            if (pos == std::string::npos)
+                break;
+            start = pos + 1;
         }
 
-        std::cerr << "[ERROR] Variable '" << fullName 
-                  << "' is undeclared or out of scope at line " << yylineno << "\n";
+        std::cerr << "[ERROR] Index " << index << " out of bounds in array '" 
+                  << text << "' at line " << yylineno << "\n";
         return "?";
     }
-}
 
+    std::cout << "[DEBUG] Variable '" << text << "' is NOT an array.\n";
+    std::cout << "[DEBUG] Found variable '" << text 
+              << "' in domain: '" << symbols.name(v.domain) 
+              << "' with value: " << v.value << "\n";
+    return v.value;
+}
 
-// Returneaza tipul complet (ex: "int", "int[10]", etc.) al unui obiect
-std::string getTypeOfObject(const std::string& name, int yylineno)
+// Returneaza variabila cu numele dat, din orice domeniu (ex: obiectul din nr.x)
+VarSymbol* getObject(SymbolId name, int yylineno)
 {
     for (int i = 0; i < varsNumber; i++)
     {
         if (vars[i].name == name)
         {
-            return vars[i].type;
+            return &vars[i];
         }
     }
     std::cerr << "[Line " << yylineno << "] Error: Variable " 
-              << name << " is not declared\n";
-    std::exit(EXIT_FAILURE);
+              << symbols.name(name) << " is not declared\n";
+    abortCompilation();
 }
 
-// Returneaza tipul efectiv (ex: "int", "float", "bool") al unei variabile sau al unui element de tablou
-std::string getVarType(const std::string& fullName)
+// Returneaza tipul complet (ex: int sau int[10]) al unui obiect
+TypeInfo getTypeOfObject(SymbolId name, int yylineno)
 {
-    // variabila simpla
-    if (fullName.find('[') == std::string::npos)
-    {
-        // local
-        for (int i = 0; i < varsNumber; i++)
-            if (vars[i].name == fullName && vars[i].domain == domain)
-                return vars[i].type;
-        // functionDomain
-        for (int i = 0; i < varsNumber; i++)
-            if (vars[i].name == fullName && vars[i].domain == functionDomain)
-                return vars[i].type;
-        // global
-        for (int i = 0; i < varsNumber; i++)
-            if (vars[i].name == fullName && vars[i].domain == "global")
-                return vars[i].type;
-    }
-    else
-    {
-        // e array
-        auto pos1 = fullName.find('[');
-        if (pos1 == std::string::npos) 
-            return "?";
-        std::string localIdent = fullName.substr(0, pos1);
-
-        // local
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == localIdent && vars[i].domain == domain)
-            {
-                if (vars[i].type.find("int")   != std::string::npos) return "int";
-                if (vars[i].type.find("float") != std::string::npos) return "float";
-                if (vars[i].type.find("bool")  != std::string::npos) return "bool";
-            }
-        }
-        // functionDomain
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == localIdent && vars[i].domain == functionDomain)
-            {
-                if (vars[i].type.find("int")   != std::string::npos) return "int";
-                if (vars[i].type.find("float") != std::string::npos) return "float";
-                if (vars[i].type.find("bool")  != std::string::npos) return "bool";
-            }
-        }
-        // global
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == localIdent && vars[i].domain == "global")
-            {
-                if (vars[i].type.find("int")   != std::string::npos) return "int";
-                if (vars[i].type.find("float") != std::string::npos) return "float";
-                if (vars[i].type.find("bool")  != std::string::npos) return "bool";
-            }
-        }
-    }
-    return "?";
+    return getObject(name, yylineno)->type;
 }
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //                FUNCTII DE ACTUALIZARE
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
-void updateVarValue(const std::string& fullName, const ResultAST& value, int yylineno)
+// Verificarile unei atribuiri, facute la parsare: variabila declarata, nu e const, acelasi tip
+void checkAssign(LValue& target, Category valueType, int yylineno)
 {
-    // variabila simpla (fara index)
-    if (fullName.find('[') == std::string::npos)
+    if (!target.var)
+        target.var = findVar(target.name);
+    VarSymbol* v = target.var;
+    if (!v)
     {
-        auto updateSimpleVar = [&](VarSymbol& v)
-        {
-            if (v.isConst)
-            {
-                std::cerr << "[Line " << yylineno << "] Error: The value of constant variable "
-                          << fullName << " cannot be modified\n";
-                std::exit(EXIT_FAILURE);
-            }
-            if (value.treeType != Category::OTHER &&
-                convertStringToEnum(v.type) != value.treeType)
-            {
-                std::cerr << "[Line " << yylineno << "] Error: The language does not support casting for variable "
-                          << fullName << "\n";
-                std::exit(EXIT_FAILURE);
-            }
-            v.value = value.resultStr;
-        };
+        std::cerr << "[Line " << yylineno << "] Error: Undeclared variable " 
+                  << symbols.name(target.name) << " used in expression\n";
+        abortCompilation();
+    }
 
-        // local
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == fullName && vars[i].domain == domain)
-            {
-                updateSimpleVar(vars[i]);
-                return;
-            }
-        }
-        // functionDomain
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == fullName && vars[i].domain == functionDomain)
-            {
-                updateSimpleVar(vars[i]);
-                return;
-            }
-        }
-        // global
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == fullName && vars[i].domain == "global")
-            {
-                updateSimpleVar(vars[i]);
-                return;
-            }
-        }
+    if (v->isConst)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: The value of constant "
+                  << (target.index ? "array " : "") << "variable "
+                  << symbols.name(target.name) << " cannot be modified\n";
+        abortCompilation();
     }
-    else
+    if (valueType != Category::OTHER && v->type.base != valueType)
     {
-        // e array
-        extract_Id_And_Index(fullName, yylineno);
-        int index = std::stoi(indexStr);
-        checkValidIndex(identif, index, yylineno);
+        std::cerr << "[Line " << yylineno << "] Error: The language does not support casting for variable "
+                  << symbols.name(target.name) << "\n";
+        abortCompilation();
+    }
+}
 
-        auto updateValueInArray = [&](VarSymbol& v)
-        {
-            if (v.isConst)
-            {
-                std::cerr << "[Line " << yylineno << "] Error: The value of constant array variable "
-                          << v.name << " cannot be modified\n";
-                std::exit(EXIT_FAILURE);
-            }
-            if (value.treeType != Category::OTHER &&
-                convertStringToEnum(v.type) != value.treeType)
-            {
-                std::cerr << "[Line " << yylineno << "] Error: The language does not support casting for variable "
-                          << v.name << "\n";
-                std::exit(EXIT_FAILURE);
-            }
+// Scrie valoarea in variabila (index < 0) sau in elementul index al array-ului
+void updateVarValue(VarSymbol& v, int index, const ResultAST& value, int yylineno, bool checkBounds = true)
+{
+    checkNegativeIndex(index, checkBounds, yylineno);
 
-            // despartim prin spatiu, actualizam indexul respectiv
-            std::string newValues;
-            std::string oldVals = v.value;
-            int contor = 0;
-            size_t start = 0;
-            while (true)
-            {
-                auto pos = oldVals.find(' ', start);
-                std::string token;
-                if (pos != std::string::npos)
-                    token = oldVals.substr(start, pos - start);
-                else
-                    token = oldVals.substr(start);
+    // variabila simpla (fara index)
+    if (index < 0)
+    {
+        storeValue(v, value);
+        return;
+    }
 
-                if (contor == index)
-                    newValues += value.resultStr;
-                else
-                    newValues += token;
+    // e array: despartim prin spatiu, actualizam indexul respectiv
+    if (checkBounds)
+        checkValidIndex(v, index, yylineno);
 
-                contor++;
-                if (pos == std::string::npos)
-                    break;
-                newValues += " ";
-                start = pos + 1;
-            }
-            v.value = newValues;
-        };
+    std::string newValues;
+    const std::string& oldVals = v.value;
+    int contor = 0;
+    size_t start = 0;
+    while (true)
+    {
+        auto pos = oldVals.find(' ', start);
+        if (contor == index)
+            newValues += resultText(value);
+        else if (pos != std::string::npos)
+            newValues.append(oldVals, start, pos - start);
+        else
+            newValues.append(oldVals, start, std::string::npos);
 
-        // local
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == domain)
-            {
-                updateValueInArray(vars[i]);
-                return;
-            }
-        }
-        // functionDomain
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == functionDomain)
-            {
-                updateValueInArray(vars[i]);
-                return;
-            }
-        }
-        // global
-        for (int i = 0; i < varsNumber; i++)
-        {
-            if (vars[i].name == identif && vars[i].domain == "global")
-            {
-                updateValueInArray(vars[i]);
-                return;
-            }
-        }
+        contor++;
+        if (pos == std::string::npos)
+            break;
+        newValues += " ";
+        start = pos + 1;
     }
-
-    // daca nu l-am gasit
-    std::cerr << "[Line " << yylineno << "] Error: Undeclared variable " 
-              << fullName << " used in expression\n";
-    std::exit(EXIT_FAILURE);
+    v.value = newValues;
 }
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -720,7 +785,9 @@ std::string categoryToString(Category category) {
         case Category::STRING: return "STRING";
         case Category::OPERATOR: return "OPERATOR";
         case Category::IDENTIFIER: return "IDENTIFIER";
+        case Category::CALL: return "CALL";
         case Category::OTHER: return "OTHER";
+        case Category::CHANNEL: return "CHANNEL";
         default: return "UNKNOWN";
     }
 }
@@ -737,27 +804,12 @@ AST* buildTree(const std::string& label, Category category, AST* left, AST* righ
     node->category = category;
     node->left     = left;
     node->right    = right;
+    if (category == Category::STRING && !left && !right)
+        node->text = label;
 
     if (!node->left && !node->right) 
     {
-        if (category == Category::IDENTIFIER) 
-        {
-            std::string type = getVarType(label);
-            if (type == "?") 
-            {
-                std::cerr << "[ERROR] Undeclared variable '" << label 
-                          << "' used in expression at line " << yylineno << "\n";
-                std::exit(EXIT_FAILURE);
-            } 
-            else 
-            {
-                node->treeType = convertStringToEnum(type);
-            }
-        } 
-        else 
-        {
-            node->treeType = category;
-        }
+        node->treeType = category;
     }
     else 
     {
@@ -767,7 +819,12 @@ AST* buildTree(const std::string& label, Category category, AST* left, AST* righ
                       << categoryToString(node->left->treeType) << " and " 
                       << categoryToString(node->right->treeType) 
                       << " at line " << yylineno << "\n";
-            std::exit(EXIT_FAILURE);
+            abortCompilation();
+        }
+        else if (category == Category::NUMBER_BOOL)
+        {
+            // comparatiile si operatorii logici dau mereu bool
+            node->treeType = Category::NUMBER_BOOL;
         }
         else 
         {
@@ -778,7 +835,154 @@ AST* buildTree(const std::string& label, Category category, AST* left, AST* righ
     return node;
 }
 
+// Frunza pentru o variabila (sau element de array, daca index != nullptr)
+AST* buildVarTree(SymbolId name, AST* index, int yylineno)
+{
+    std::string label = symbols.name(name);
+    if (index)
+        label += "[" + index->label + "]";
+
+    VarSymbol* v = findVar(name);
+    if (!v) 
+    {
+        std::cerr << "[ERROR] Undeclared variable '" << label 
+                  << "' used in expression at line " << yylineno << "\n";
+        abortCompilation();
+    } 
+
+    AST* node = buildTree(label, Category::IDENTIFIER, nullptr, nullptr, yylineno);
+    node->treeType = v->type.base;
+    node->sym      = name;
+    node->var      = v;
+    node->index    = index;
+    return node;
+}
+
+VarSymbol* isIdInClass(SymbolId object, SymbolId id, int yylineno);
+
+// Atributul field al obiectului object (ex: nr.x)
+AST* buildFieldTree(SymbolId object, SymbolId field, int yylineno)
+{
+    VarSymbol* v = isIdInClass(object, field, yylineno);
+
+    AST* node = buildTree(symbols.name(object) + "." + symbols.name(field),
+                          Category::IDENTIFIER, nullptr, nullptr, yylineno);
+    node->treeType = v->type.base;
+    node->sym      = field;
+    node->var      = v;
+    node->object   = getObject(object, yylineno);
+    return node;
+}
+
+// Apelul functiei func[funcIndex]; tipul nodului e tipul returnat
+AST* buildCallTree(int funcIndex, std::vector<AST*>* callArgs, int yylineno)
+{
+    AST* node = buildTree(symbols.name(func[funcIndex].name), Category::CALL, nullptr, nullptr, yylineno);
+    node->treeType  = func[funcIndex].returnType.base;
+    node->funcIndex = funcIndex;
+    node->args      = std::move(*callArgs);
+    delete callArgs;
+    return node;
+}
+
+std::string argsToString(const std::vector<AST*>& callArgs)
+{
+    if (callArgs.empty())
+        return "-";
+    std::string text;
+    for (AST* arg : callArgs)
+    {
+        if (!text.empty())
+            text += ", ";
+        text += convertEnumToString(arg->treeType);
+    }
+    return text;
+}
+
+// Valoarea de adevar a unei conditii
+bool isTrue(const ResultAST& res)
+{
+    switch (res.treeType)
+    {
+        case Category::NUMBER_BOOL:  return res.resultStr == "true";
+        case Category::NUMBER_FLOAT: return std::stof(res.resultStr) != 0.0f;
+        case Category::STRING:       return !res.text.empty();
+        default:                     return !res.resultStr.empty() && res.resultStr != "0";
+    }
+}
+
+// Compara doi operanzi de acelasi tip: < 0, 0 sau > 0
+int compareValues(const ResultAST& left, const ResultAST& right)
+{
+    switch (left.treeType)
+    {
+        case Category::NUMBER_INT:
+        {
+            int lv = std::stoi(left.resultStr);
+            int rv = std::stoi(right.resultStr);
+            return (lv > rv) - (lv < rv);
+        }
+        case Category::NUMBER_FLOAT:
+        {
+            float lv = std::stof(left.resultStr);
+            float rv = std::stof(right.resultStr);
+            return (lv > rv) - (lv < rv);
+        }
+        case Category::STRING:
+            return left.text.str().compare(right.text.str());
+        default:    // bool, char: comparam textul
+            return left.resultStr.compare(right.resultStr);
+    }
+}
+
+// Rezultatul comparatiei op (<, >, <=, >=, ==, !=) pentru cmp dat de compareValues
+bool relationHolds(const std::string& op, int cmp)
+{
+    return (op == "<")  ? cmp <  0 :
+           (op == ">")  ? cmp >  0 :
+           (op == "<=") ? cmp <= 0 :
+           (op == ">=") ? cmp >= 0 :
+           (op == "==") ? cmp == 0 : cmp != 0;
+}
+
+// Operatiile aritmetice, comune interpretorului si kernelului din parallel for.
+// Intorc false la impartirea la zero. Intregii se calculeaza pe 64 de biti, apoi
+// se trunchiaza la 32 (wrap-around): depasirea si INT_MIN / -1 dau un rezultat
+// definit, nu comportament nedefinit.
+bool intArithmetic(char op, std::int32_t l, std::int32_t r, std::int32_t& out)
+{
+    long long lv = l, rv = r;
+    if ((op == '/' || op == '%') && rv == 0)
+        return false;
+
+    long long value = (op == '+') ? lv + rv :
+                      (op == '-') ? lv - rv :
+                      (op == '*') ? lv * rv :
+                      (op == '/') ? lv / rv :
+                      (op == '%') ? lv % rv : 0;
+    out = static_cast<std::int32_t>(static_cast<std::uint32_t>(value));
+    return true;
+}
+
+bool floatArithmetic(char op, float l, float r, float& out)
+{
+    if (op == '/' && r == 0.0f)
+        return false;
+
+    out = (op == '+') ? l + r :
+          (op == '-') ? l - r :
+          (op == '*') ? l * r :
+          (op == '/') ? l / r : 0.0f;
+    return true;
+}
+
+ResultAST callFunction(int funcIndex, const std::vector<AST*>& callArgs, int yylineno);
+ResultAST channelOp(AST* node, int yylineno);
 
+#ifdef LFAC_FUZZ
+constexpr long long FUZZ_BUDGET = 20000; // noduri evaluate per input, pt. harness-uri
+long long fuzzBudget = FUZZ_BUDGET;
+#endif
 
 ResultAST evaluateTree(AST* root, int yylineno)
 {
@@ -787,14 +991,50 @@ ResultAST evaluateTree(AST* root, int yylineno)
     if (!root)
     {
         std::cerr << "[ERROR] Null node encountered in AST evaluation at line " << yylineno << "\n";
-        std::exit(EXIT_FAILURE);
+        abortCompilation();
+    }
+
+#ifdef LFAC_FUZZ
+    // orice bucla infinita evalueaza conditia la fiecare pas, deci se opreste aici
+    if (--fuzzBudget < 0)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Evaluation budget exceeded.\n";
+        abortCompilation();
     }
+#endif
 
     std::cout << "[DEBUG] Evaluating node: " << root->label 
               << " (type: " << categoryToString(root->category) 
               << ") at line " << yylineno << "\n";
 
-    if (root->left && root->right) //  Operator binar
+    if (root->category == Category::NUMBER_BOOL && root->left) // Operatori logici / de comparatie
+    {
+        std::cout << "[DEBUG] Processing boolean operator: " << root->label << "\n";
+
+        bool value;
+        if (root->label == "!")
+        {
+            value = !isTrue(evaluateTree(root->left, yylineno));
+        }
+        else if (root->label == "&&")   // scurtcircuitare, ca in C
+        {
+            value = isTrue(evaluateTree(root->left, yylineno)) &&
+                    isTrue(evaluateTree(root->right, yylineno));
+        }
+        else if (root->label == "||")
+        {
+            value = isTrue(evaluateTree(root->left, yylineno)) ||
+                    isTrue(evaluateTree(root->right, yylineno));
+        }
+        else
+        {
+            auto left  = evaluateTree(root->left, yylineno);
+            auto right = evaluateTree(root->right, yylineno);
+            value = relationHolds(root->label, compareValues(left, right));
+        }
+        res.resultStr = value ? "true" : "false";
+    }
+    else if (root->left && root->right) //  Operator binar
     {
         std::cout << "[DEBUG] Processing binary operator: " << root->label << "\n";
 
@@ -809,76 +1049,106 @@ ResultAST evaluateTree(AST* root, int yylineno)
                       << " (" << categoryToString(root->left->treeType) << ")\n";
             std::cerr << "       - Right operand: " << root->right->label 
                       << " (" << categoryToString(root->right->treeType) << ")\n";
-            std::exit(EXIT_FAILURE);
+            abortCompilation();
         }
 
         if (root->treeType == Category::NUMBER_FLOAT)
         {
-            float lv = std::stof(left.resultStr);
-            float rv = std::stof(right.resultStr);
-
-            if (root->label == "/" && rv == 0.0f)
+            float value;
+            if (!floatArithmetic(root->label[0], std::stof(left.resultStr), std::stof(right.resultStr), value))
             {
                 std::cerr << "[Line " << yylineno << "] Error: Division by zero is not possible.\n";
-                std::exit(EXIT_FAILURE);
+                abortCompilation();
             }
-
-            float rvv = (root->label == "+") ? lv + rv :
-                        (root->label == "-") ? lv - rv :
-                        (root->label == "*") ? lv * rv :
-                        (root->label == "/") ? lv / rv : 0.0f;
-
-            res.resultStr = ftoaCustom(rvv);
+            res.resultStr = ftoaCustom(value);
         }
         else if (root->treeType == Category::NUMBER_INT)
         {
-            int lv = std::stoi(left.resultStr);
-            int rv = std::stoi(right.resultStr);
-
-            if ((root->label == "/" || root->label == "%") && rv == 0)
+            std::int32_t value;
+            if (!intArithmetic(root->label[0], std::stoi(left.resultStr), std::stoi(right.resultStr), value))
             {
                 std::cerr << "[Line " << yylineno << "] Error: Division by zero is not possible.\n";
-                std::exit(EXIT_FAILURE);
+                abortCompilation();
+            }
+            res.resultStr = itoaCustom(value);
+        }
+        else if (root->treeType == Category::STRING)
+        {
+            if (root->label == "+")
+            {
+                res.text = left.text + right.text;   // nod de concatenare, O(1)
+            }
+            else if (root->label == "-" || root->label == "*" ||
+                     root->label == "/" || root->label == "%")
+            {
+                std::cerr << "[Line " << yylineno << "] Error: Operator " << root->label
+                          << " is not supported for strings.\n";
+                abortCompilation();
             }
-
-            int rvv = (root->label == "+") ? lv + rv :
-                      (root->label == "-") ? lv - rv :
-                      (root->label == "*") ? lv * rv :
-                      (root->label == "/") ? lv / rv :
-                      (root->label == "%") ? lv % rv : 0;
-
-            res.resultStr = itoaCustom(rvv);
         }
     }
-    else if (!root->left)  // 🔹 Frunza (valoare sau variabila)
+    else if (!root->left)  // 🔹 Frunza (valoare, variabila sau apel)
     {
         std::cout << "[DEBUG] Processing leaf node: " << root->label << "\n";
 
-        if (root->category == Category::NUMBER_INT ||
-            root->category == Category::NUMBER_FLOAT ||
-            root->category == Category::NUMBER_BOOL ||
-            root->category == Category::CHAR ||
-            root->category == Category::STRING)
+        if (root->category == Category::CALL)
+        {
+            res = callFunction(root->funcIndex, root->args, yylineno);
+        }
+        else if (root->category == Category::CHANNEL)
+        {
+            res = channelOp(root, yylineno);
+        }
+        else if (root->category == Category::STRING)
+        {
+            res.text = root->text;
+        }
+        else if (root->category == Category::NUMBER_INT ||
+                 root->category == Category::NUMBER_FLOAT ||
+                 root->category == Category::NUMBER_BOOL ||
+                 root->category == Category::CHAR)
         {
             res.resultStr = root->label;
         }
+        else if (root->category == Category::IDENTIFIER &&
+                 root->treeType == Category::STRING && !root->index)
+        {
+            // sirul nu se copiaza: doar se partajeaza RtString-ul variabilei
+            res.text = root->var->text;
+        }
         else if (root->category == Category::IDENTIFIER)
         {
             std::cout << "[DEBUG] Fetching value for identifier: " << root->label << "\n";
-            res.resultStr = getVarValue(root->label, yylineno);
+            int index = -1;
+            if (root->indexSafe)
+                index = std::stoi(evaluateTree(root->index, yylineno).resultStr);
+            else if (root->index)
+                index = checkIndex(evaluateTree(root->index, yylineno), yylineno);
+            res.resultStr = getVarValue(*root->var, index, yylineno, !root->indexSafe);
 
             if (res.resultStr == "?")  // Variabila nu a fost gasita!
             {
                 std::cerr << "[Line " << yylineno << "] Error: Undeclared variable '" 
                           << root->label << "' used in expression.\n";
-                std::exit(EXIT_FAILURE);
+                abortCompilation();
+            }
+            if (root->treeType == Category::STRING)   // element dintr-un array de string
+            {
+                res.text = res.resultStr;
+                res.resultStr.clear();
             }
         }
     }
 
     res.treeType = root->treeType;
-    std::cout << "[DEBUG] Evaluation result: " << res.resultStr 
-              << " (type: " << categoryToString(res.treeType) 
+    std::cout << "[DEBUG] Evaluation result: ";
+    if (res.treeType != Category::STRING)
+        std::cout << res.resultStr;
+    else if (res.text.size() <= RtString::CHUNK_MAX)
+        std::cout << res.text;
+    else
+        std::cout << "<string of " << res.text.size() << " chars>";
+    std::cout << " (type: " << categoryToString(res.treeType) 
               << ") at line " << yylineno << "\n";
 
     return res;
@@ -886,41 +1156,355 @@ ResultAST evaluateTree(AST* root, int yylineno)
 
 
 
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//         ANALIZA DE INTERVALE PENTRU INDECSI (la compilare)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Dupa parsarea unui corp (functie, main, element REPL) calculam pentru fiecare
+// index v[e] un interval [lo, hi] al valorilor lui e. Variabilele cunoscute sunt
+// contoarele buclelor for de forma
+//     for (i = a; i < b; i = i + c) { ... }   (sau <=, ori descrescator cu > / >=)
+// cu a, b constante (sau expresii de contoare exterioare) si i neatribuit in corp.
+// Daca i e global sau atribut, o functie apelata din corp l-ar putea modifica:
+// atunci bucla se accepta doar daca in corp nu exista apeluri.
+// Un index dovedit in [0, dim) nu se mai verifica la rulare (indexSafe); un index
+// constant in afara array-ului e eroare de compilare.
+
+struct Range
+{
+    bool      known    = false;
+    bool      constant = false; // nu depinde de nicio variabila
+    long long lo = 0, hi = 0;
+};
+
+struct RangeBinding
+{
+    VarSymbol* var;
+    Range      range;
+};
+using RangeEnv = std::vector<RangeBinding>;
+
+struct BoundsStats
+{
+    int accesses = 0;  // accese cu index in array-uri
+    int removed  = 0;  // din care fara verificare la rulare
+};
+
+Range makeRange(long long lo, long long hi, bool constant)
+{
+    Range r;
+    // in afara lui int valorile ar face wrap-around: nu mai stim nimic
+    r.known    = lo >= INT32_MIN && hi <= INT32_MAX;
+    r.constant = constant;
+    r.lo = lo;
+    r.hi = hi;
+    return r;
+}
+
+Range rangeOf(const AST* node, const RangeEnv& env)
+{
+    if (!node || node->treeType != Category::NUMBER_INT)
+        return Range();
+
+    if (node->category == Category::NUMBER_INT && !node->left)
+    {
+        long long value = std::stoll(node->label);
+        return makeRange(value, value, true);
+    }
+    if (node->category == Category::IDENTIFIER && !node->index)
+    {
+        for (auto it = env.rbegin(); it != env.rend(); ++it)
+            if (it->var == node->var)
+                return it->range;
+        return Range();
+    }
+    if (node->category != Category::OPERATOR || !node->left || !node->right)
+        return Range();
+
+    Range l = rangeOf(node->left, env);
+    Range r = rangeOf(node->right, env);
+    if (!l.known || !r.known)
+        return Range();
+    bool constant = l.constant && r.constant;
+
+    const std::string& op = node->label;
+    if (op == "+")
+        return makeRange(l.lo + r.lo, l.hi + r.hi, constant);
+    if (op == "-")
+        return makeRange(l.lo - r.hi, l.hi - r.lo, constant);
+    if (op == "*")
+    {
+        long long p[] = {l.lo * r.lo, l.lo * r.hi, l.hi * r.lo, l.hi * r.hi};
+        return makeRange(*std::min_element(p, p + 4), *std::max_element(p, p + 4), constant);
+    }
+    // impartire / rest doar pt. deimpartit >= 0 si impartitor constant > 0 (ex. v[i % 10])
+    if ((op == "/" || op == "%") && l.lo >= 0 && r.lo == r.hi && r.lo > 0)
+    {
+        if (op == "/")
+            return makeRange(l.lo / r.lo, l.hi / r.lo, constant);
+        if (constant)
+            return makeRange(l.lo % r.lo, l.lo % r.lo, true);
+        return makeRange(0, std::min(l.hi, r.lo - 1), false);
+    }
+    return Range();
+}
+
+// Apel de functie sau operatie pe canal (in timpul careia pot rula alte task-uri)
+bool containsCall(const AST* node)
+{
+    if (!node)
+        return false;
+    if (node->category == Category::CALL || node->category == Category::CHANNEL)
+        return true;
+    return containsCall(node->left) || containsCall(node->right) || containsCall(node->index);
+}
+
+// Expresia contine c.recv(v), care scrie in v
+bool receivesInto(const AST* node, const VarSymbol* v)
+{
+    if (!node)
+        return false;
+    if (node->category == Category::CHANNEL && !node->args.empty() && node->args[0]->var == v &&
+        symbols.name(node->sym) == "recv")
+        return true;
+    if (receivesInto(node->left, v) || receivesInto(node->right, v) || receivesInto(node->index, v))
+        return true;
+    for (const AST* arg : node->args)
+        if (receivesInto(arg, v))
+            return true;
+    return false;
+}
+
+// Instructiunea (sau blocul) atribuie variabila v / contine un apel de functie
+bool writesVar(const Stmt* st, const VarSymbol* v, bool& hasCall);
+
+bool writesVar(const std::vector<Stmt*>& block, const VarSymbol* v, bool& hasCall)
+{
+    bool writes = false;
+    for (const Stmt* st : block)
+        writes = writesVar(st, v, hasCall) || writes;
+    return writes;
+}
+
+bool writesVar(const Stmt* st, const VarSymbol* v, bool& hasCall)
+{
+    if (!st)
+        return false;
+    hasCall = hasCall || containsCall(st->expr) || containsCall(st->target.index);
+    bool writes = (st->kind == StmtKind::ASSIGN || st->kind == StmtKind::DECL) && st->target.var == v;
+    writes = writes || receivesInto(st->expr, v) || receivesInto(st->target.index, v);
+    writes = writesVar(st->init, v, hasCall) || writes;
+    writes = writesVar(st->step, v, hasCall) || writes;
+    writes = writesVar(st->body, v, hasCall) || writes;
+    writes = writesVar(st->elseBody, v, hasCall) || writes;
+    return writes;
+}
+
+int classIndex(SymbolId name)
+{
+    for (int i = 0; i < classNumber; i++)
+        if (classes[i].name == name)
+            return i;
+    return -1;
+}
+
+bool loopCallsReach(const Stmt* loop, SymbolId dom);
+
+// Intervalul contorului unei bucle for in corpul ei (known == false daca nu il stim)
+Range loopRange(const Stmt* loop, const RangeEnv& env, VarSymbol*& counter)
+{
+    const Stmt* init = loop->init;
+    const Stmt* step = loop->step;
+    const AST*  cond = loop->expr;
+    if (!init || !step || !cond || init->kind != StmtKind::ASSIGN || step->kind != StmtKind::ASSIGN)
+        return Range();
+
+    counter = init->target.var;
+    if (!counter || init->target.index || counter->type.base != Category::NUMBER_INT || counter->type.dim)
+        return Range();
+
+    // conditia: i < b, i <= b, i > b sau i >= b
+    if (cond->category != Category::NUMBER_BOOL || !cond->left || !cond->right ||
+        cond->left->category != Category::IDENTIFIER || cond->left->var != counter || cond->left->index)
+        return Range();
+    Range start = rangeOf(init->expr, env);
+    Range bound = rangeOf(cond->right, env);
+
+    // pasul: i = i + c sau i = i - c, cu c constant > 0
+    const AST* inc = step->expr;
+    if (step->target.var != counter || step->target.index || !inc || !inc->left || !inc->right ||
+        inc->left->category != Category::IDENTIFIER || inc->left->var != counter || inc->left->index)
+        return Range();
+    Range delta = rangeOf(inc->right, env);
+    if (!start.known || !bound.known || !delta.constant || !delta.known || delta.lo <= 0)
+        return Range();
+
+    bool hasCall = containsCall(cond) || containsCall(inc);
+    if (writesVar(loop->body, counter, hasCall))
+        return Range();
+    // un apel poate scrie contorul daca e global, atribut, sau local al unei functii
+    // la care ajung apelurile din bucla (ex. chiar functia curenta, prin recursivitate)
+    bool escapes = counter->domain == SYM_GLOBAL || classIndex(counter->domain) >= 0;
+    if (hasCall && (escapes || loopCallsReach(loop, counter->domain)))
+        return Range();
+
+    // i nu trebuie sa faca wrap-around inainte ca conditia sa devina falsa
+    const std::string& op = cond->label;
+    if (inc->label == "+" && (op == "<" || op == "<="))
+    {
+        long long hi = (op == "<") ? bound.hi - 1 : bound.hi;
+        if (hi + delta.lo > INT32_MAX)
+            return Range();
+        return makeRange(start.lo, hi, false);
+    }
+    if (inc->label == "-" && (op == ">" || op == ">="))
+    {
+        long long lo = (op == ">") ? bound.lo + 1 : bound.lo;
+        if (lo - delta.lo < INT32_MIN)
+            return Range();
+        return makeRange(lo, start.hi, false);
+    }
+    return Range();
+}
+
+// Decide pentru un acces v[index]; intoarce true daca verificarea se poate elimina
+bool checkAccessStatically(const VarSymbol* v, const AST* index, const RangeEnv& env,
+                           BoundsStats& stats, int yylineno)
+{
+    if (!v || !index || v->type.dim == 0)
+        return false;
+    stats.accesses++;
+
+    Range r = rangeOf(index, env);
+    if (r.known && r.constant && (r.lo < 0 || r.lo >= v->type.dim))
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Index " << r.lo << " is out of bounds for array "
+                  << symbols.name(v->name) << "[" << v->type.dim << "]\n";
+        abortCompilation();
+    }
+    if (r.known && r.lo >= 0 && r.hi < v->type.dim)
+    {
+        stats.removed++;
+        return true;
+    }
+    return false;
+}
+
+void analyzeExpr(AST* node, const RangeEnv& env, BoundsStats& stats, int yylineno)
+{
+    if (!node)
+        return;
+    analyzeExpr(node->left, env, stats, yylineno);
+    analyzeExpr(node->right, env, stats, yylineno);
+    analyzeExpr(node->index, env, stats, yylineno);
+    for (AST* arg : node->args)
+        analyzeExpr(arg, env, stats, yylineno);
+    if (node->category == Category::IDENTIFIER && node->index)
+        node->indexSafe = checkAccessStatically(node->var, node->index, env, stats, yylineno);
+}
+
+void analyzeBlock(const std::vector<Stmt*>& block, RangeEnv& env, BoundsStats& stats);
+
+void analyzeStmt(Stmt* st, RangeEnv& env, BoundsStats& stats)
+{
+    if (!st)
+        return;
+    analyzeExpr(st->expr, env, stats, st->line);
+    if (st->target.index)
+    {
+        analyzeExpr(st->target.index, env, stats, st->line);
+        st->target.indexSafe = checkAccessStatically(st->target.var, st->target.index, env, stats, st->line);
+    }
+    analyzeStmt(st->init, env, stats);
+    analyzeStmt(st->step, env, stats);
+
+    if (st->kind == StmtKind::FOR || st->kind == StmtKind::PARALLEL_FOR)
+    {
+        VarSymbol* counter = nullptr;
+        Range r = loopRange(st, env, counter);
+        if (r.known)
+            env.push_back({counter, r});
+        analyzeBlock(st->body, env, stats);
+        if (r.known)
+            env.pop_back();
+    }
+    else
+    {
+        analyzeBlock(st->body, env, stats);
+    }
+    analyzeBlock(st->elseBody, env, stats);
+}
+
+void analyzeBlock(const std::vector<Stmt*>& block, RangeEnv& env, BoundsStats& stats)
+{
+    for (Stmt* st : block)
+        analyzeStmt(st, env, stats);
+}
+
+// Punctul de intrare, apelat din parser pentru fiecare corp complet
+void analyzeBounds(const std::vector<Stmt*>& body)
+{
+    RangeEnv    env;
+    BoundsStats stats;
+    analyzeBlock(body, env, stats);
+    if (stats.accesses)
+        std::cout << "[DEBUG] Bounds checks removed: " << stats.removed << " of "
+                  << stats.accesses << " array accesses\n";
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 //         FUNCTII „SPECIALE” (Print, TypeOf, etc.)
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
+ProgramOutput programOutput;     // stdout (prin buffer), un fisier sau un fd
+
 void Print(const ResultAST& expr, int yylineno) {
-    std::cout << "Function Print was called at line " << yylineno 
-              << ". The result is: " << expr.resultStr << std::endl;
+    std::ostream& out = *programOutput.stream;
+    if (!programOutput.raw)
+    {
+        out << "Function Print was called at line ";
+        writeNumber(out, yylineno);
+        out << ". The result is: ";
+    }
+    if (expr.treeType == Category::STRING)
+        out << expr.text;
+    else
+        out << expr.resultStr;
+    out << '\n';
 }
 
 void TypeOf(const ResultAST& expr, int yylineno)
 {
-    std::cout << "Function TypeOf was called at line " << yylineno 
-              << ". The type is: " << convertEnumToString(expr.treeType) << "\n";
+    std::ostream& out = *programOutput.stream;
+    if (!programOutput.raw)
+    {
+        out << "Function TypeOf was called at line ";
+        writeNumber(out, yylineno);
+        out << ". The type is: ";
+    }
+    out << convertEnumToString(expr.treeType) << '\n';
 }
 
-// Verifica daca id este atribut in clasa obiectului object
-void isIdInClass(const std::string& object, const std::string& id, int yylineno)
+// Verifica daca id este atribut in clasa obiectului object; intoarce atributul
+VarSymbol* isIdInClass(SymbolId object, SymbolId id, int yylineno)
 {
-    std::string clasa = getTypeOfObject(object, yylineno);
+    SymbolId clasa = getTypeOfObject(object, yylineno).name;
     for (int i = 0; i < varsNumber; i++)
     {
         if (vars[i].domain == clasa && vars[i].name == id)
         {
-            return;
+            return &vars[i];
         }
     }
-    std::cerr << "[Line " << yylineno << "] Error: Variable " << id 
-              << " is not declared in class " << clasa << "\n";
-    std::exit(EXIT_FAILURE);
+    std::cerr << "[Line " << yylineno << "] Error: Variable " << symbols.name(id) 
+              << " is not declared in class " << symbols.name(clasa) << "\n";
+    abortCompilation();
 }
 
 // Verifica daca function este metoda in clasa obiectului object
-void isMemberInClass(const std::string& object, const std::string& funcName, int yylineno)
+void isMemberInClass(SymbolId object, SymbolId funcName, int yylineno)
 {
-    std::string clasa = getTypeOfObject(object, yylineno);
+    SymbolId clasa = getTypeOfObject(object, yylineno).name;
     for (int i = 0; i < funcNumber; i++)
     {
         if (func[i].domain == clasa && func[i].name == funcName)
@@ -928,9 +1512,3639 @@ void isMemberInClass(const std::string& object, const std::string& funcName, int
             return;
         }
     }
-    std::cerr << "[Line " << yylineno << "] Error: Function " << funcName 
-              << " is not declared in class " << clasa << "\n";
-    std::exit(EXIT_FAILURE);
+    std::cerr << "[Line " << yylineno << "] Error: Function " << symbols.name(funcName) 
+              << " is not declared in class " << symbols.name(clasa) << "\n";
+    abortCompilation();
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//               FUNCTII DE EXECUTIE
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Parsarea doar construieste instructiunile din corpuri; main se executa dupa
+// yyparse, iar un apel de functie executa corpul inregistrat in func[].
+
+Profiler  profiler;              // activ doar cu --profile
+constexpr int MAIN_PROFILE_ID = LENMAX; // id-ul lui main in profiler (functiile au 0..LENMAX-1)
+
+bool      returning = false;     // s-a executat un `return` in functia curenta
+ResultAST returnValue;
+std::vector<int> activeCalls;    // functiile in curs de executie (in task-ul curent)
+// Nu se distruge niciodata: std::exit (la o eroare) poate rula pe stiva unui task
+Scheduler& scheduler = *new Scheduler();
+std::vector<std::vector<VarSymbol*>> frameVars;   // variabilele locale folosite de fiecare functie
+int mainFrame = 0;                                // indexul lui main in frameVars (= funcNumber)
+int framesVersion = -1;                           // funcVersion pentru care s-a calculat frameVars
+
+Stmt* makeStmt(StmtKind kind, AST* expr, int yylineno)
+{
+    Stmt* st = new Stmt();
+    st->kind = kind;
+    st->expr = expr;
+    st->line = yylineno;
+    return st;
+}
+
+// Declaratie locala pentru variabila abia adaugata (init == nullptr => valoarea implicita)
+Stmt* makeDeclStmt(AST* init, int yylineno)
+{
+    Stmt* st = makeStmt(StmtKind::DECL, init, yylineno);
+    st->target.name = vars[varsNumber - 1].name;
+    st->target.var  = &vars[varsNumber - 1];
+    return st;
+}
+
+// Valoarea implicita a unui tip (ca la declaratia fara initializare)
+ResultAST defaultValue(const TypeInfo& type)
+{
+    ResultAST res;
+    res.treeType = type.base;
+    if (type.base == Category::STRING)
+        res.text = "0";
+    else
+        res.resultStr = (type.name == SYM_BOOL) ? "false" : "0";
+    return res;
+}
+
+void execStmt(Stmt* st);
+void spawnTask(AST* call, int yylineno);
+void runParallelFor(Stmt* st);
+
+void execBlock(const std::vector<Stmt*>& block)
+{
+    for (Stmt* st : block)
+    {
+        execStmt(st);
+        if (returning)
+            return;
+    }
+}
+
+void execStmt(Stmt* st)
+{
+    if (profiler.enabled)
+        profiler.enterStatement(st->line);
+
+    switch (st->kind)
+    {
+        case StmtKind::DECL:
+        {
+            VarSymbol& v = *st->target.var;
+            if (v.type.dim > 0)
+            {
+                // array local: toate elementele revin la valoarea implicita
+                std::string init = defaultValue(v.type).resultStr;
+                v.value.clear();
+                for (int i = 0; i < v.type.dim; i++)
+                    v.value += (i ? " " : "") + init;
+            }
+            else
+            {
+                storeValue(v, st->expr ? evaluateTree(st->expr, st->line) : defaultValue(v.type));
+            }
+            break;
+        }
+        case StmtKind::ASSIGN:
+        {
+            const LValue& t = st->target;
+            int index = -1;
+            if (t.indexSafe)
+                index = std::stoi(evaluateTree(t.index, st->line).resultStr);
+            else if (t.index)
+                index = checkIndex(evaluateTree(t.index, st->line), st->line);
+            updateVarValue(*t.var, index, evaluateTree(st->expr, st->line), st->line, !t.indexSafe);
+            break;
+        }
+        case StmtKind::EXPR:
+            evaluateTree(st->expr, st->line);
+            break;
+        case StmtKind::PRINT:
+            Print(evaluateTree(st->expr, st->line), st->line);
+            break;
+        case StmtKind::TYPEOF:
+            TypeOf(evaluateTree(st->expr, st->line), st->line);
+            break;
+        case StmtKind::IF:
+            if (isTrue(evaluateTree(st->expr, st->line)))
+                execBlock(st->body);
+            else
+                execBlock(st->elseBody);
+            break;
+        case StmtKind::WHILE:
+            while (!returning && isTrue(evaluateTree(st->expr, st->line)))
+                execBlock(st->body);
+            break;
+        case StmtKind::DO_WHILE:
+            do
+            {
+                execBlock(st->body);
+            } while (!returning && isTrue(evaluateTree(st->expr, st->line)));
+            break;
+        case StmtKind::FOR:
+            for (execStmt(st->init); isTrue(evaluateTree(st->expr, st->line)); execStmt(st->step))
+            {
+                execBlock(st->body);
+                if (returning)
+                    break;
+            }
+            break;
+        case StmtKind::RETURN:
+            returnValue = evaluateTree(st->expr, st->line);
+            returning   = true;
+            break;
+        case StmtKind::SPAWN:
+            spawnTask(st->expr, st->line);
+            break;
+        case StmtKind::PARALLEL_FOR:
+            runParallelFor(st);
+            break;
+    }
+
+    if (profiler.enabled)
+        profiler.leaveStatement();
+}
+
+// Argumentele unui apel, evaluate in contextul apelantului
+std::vector<ResultAST> evaluateArgs(const std::vector<AST*>& callArgs, int yylineno)
+{
+    std::vector<ResultAST> values;
+    values.reserve(callArgs.size());
+    for (AST* arg : callArgs)
+        values.push_back(evaluateTree(arg, yylineno));
+    return values;
+}
+
+void computeFrames();
+
+// Executa corpul lui func[funcIndex], cu valorile date copiate in parametri.
+// Functiile nu au cadre proprii (parametrii si variabilele locale sunt VarSymbol-uri
+// comune), asa ca un apel recursiv (f e deja activa) salveaza valorile apelului in
+// curs si le pune inapoi la iesire; celelalte apeluri nu platesc nimic.
+ResultAST invokeFunction(int funcIndex, const std::vector<ResultAST>& values)
+{
+    FuncSymbol& f = func[funcIndex];
+    bool recursive = std::find(activeCalls.begin(), activeCalls.end(), funcIndex) != activeCalls.end();
+    std::vector<std::string> savedValues;
+    std::vector<RtString>    savedTexts;
+    if (recursive)
+    {
+        if (framesVersion != funcVersion)
+            computeFrames();
+        for (const VarSymbol* v : frameVars[funcIndex])
+        {
+            savedValues.push_back(v->value);
+            savedTexts.push_back(v->text);
+        }
+    }
+
+    for (size_t i = 0; i < f.params.size() && i < values.size(); i++)
+        storeValue(*f.params[i], values[i]);
+
+    activeCalls.push_back(funcIndex);
+    if (profiler.enabled)
+        profiler.enterFunction(funcIndex);
+
+    execBlock(f.body);
+    ResultAST res = returning ? returnValue : defaultValue(f.returnType);
+    returning = false;
+
+    if (profiler.enabled)
+        profiler.leaveFunction();
+    activeCalls.pop_back();
+
+    if (recursive)
+    {
+        size_t k = 0;
+        for (VarSymbol* v : frameVars[funcIndex])
+        {
+            v->value = std::move(savedValues[k]);
+            v->text  = std::move(savedTexts[k]);
+            k++;
+        }
+    }
+    return res;
+}
+
+// Fiecare apel interpretat ocupa cateva cadre pe stiva C++ (mai multe in build-urile
+// de debug si cu sanitizere), asa ca adancimea recursivitatii se limiteaza dupa adresa
+// de pe stiva, nu dupa numarul de apeluri. Stiva creste in jos; sub limita nu mai
+// pornim niciun apel. Pe firul principal limita se stabileste la primul apel, intr-un
+// task e capatul stivei lui (Scheduler::STACK_SIZE, cu pagina de garda dedesubt).
+constexpr std::uintptr_t STACK_MARGIN      = 512 * 1024;   // pt. expresiile din ultimul apel
+constexpr std::uintptr_t TASK_STACK_MARGIN = 128 * 1024;
+std::uintptr_t callStackLimit = 0;                        // pe firul principal
+
+void checkCallDepth(int funcIndex, int yylineno)
+{
+    auto here = reinterpret_cast<std::uintptr_t>(__builtin_frame_address(0));
+    std::uintptr_t limit = callStackLimit;
+    if (scheduler.inTask())
+    {
+        limit = reinterpret_cast<std::uintptr_t>(scheduler.stackBottom()) + TASK_STACK_MARGIN;
+    }
+    else if (callStackLimit == 0)
+    {
+        rlimit rl{};
+        std::uintptr_t size = 8 * 1024 * 1024;
+        if (getrlimit(RLIMIT_STACK, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY)
+            size = rl.rlim_cur;
+        callStackLimit = limit = here - std::max(size, 2 * STACK_MARGIN) + STACK_MARGIN;
+    }
+    if (here < limit)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Too many nested calls (stack overflow) in "
+                  << symbols.name(func[funcIndex].name) << ", " << activeCalls.size() << " calls deep\n";
+        abortCompilation();
+    }
+}
+
+ResultAST callFunction(int funcIndex, const std::vector<AST*>& callArgs, int yylineno)
+{
+    checkCallDepth(funcIndex, yylineno);
+    return invokeFunction(funcIndex, evaluateArgs(callArgs, yylineno));
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          TASK-URI SI CANALE (spawn f(a); chan int c(4);)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// `spawn f(a, b);` evalueaza argumentele si porneste f intr-un task nou; main e
+// si el un task, iar programul se termina cand s-au terminat toate. Canalele sunt
+// globale si au o capacitate fixa:
+//   c.send(x)  asteapta cat timp c e plin; eroare daca c e inchis
+//   c.recv(v)  asteapta cat timp c e gol si deschis; pune valoarea in v si da true,
+//              sau false daca c e inchis si gol
+//   c.close()  trezeste pe toti cei care asteapta la c
+// Task-urile ruleaza pe rand, pe firul interpretorului (scheduler.hpp): tabelele,
+// variabilele si arborii sunt globali, deci nu pot fi folositi din mai multe fire.
+// Un task cedeaza doar cand asteapta la un canal. Functiile nu au cadre proprii
+// (parametrii si variabilele locale sunt VarSymbol-uri comune), asa ca la fiecare
+// comutare se salveaza variabilele locale ale functiilor active in task, iar cand
+// task-ul continua se pun inapoi.
+
+struct Channel
+{
+    SymbolId              name;
+    TypeInfo              type;          // tipul elementelor (scalar)
+    int                   capacity = 1;
+    std::deque<ResultAST> items;
+    bool                  closed = false;
+    std::deque<int>       senders;       // task-urile care asteapta loc in canal
+    std::deque<int>       receivers;     // task-urile care asteapta o valoare
+};
+std::vector<Channel> channels;
+
+bool spawnUsed = false;                  // programul contine cel putin un `spawn`
+bool cooperativeTasks = false;           // --cooperative-tasks: `spawn` e permis
+
+// Task-urile ruleaza pe rand, pe firul interpretorului (nu in paralel): spawn cere
+// optiunea explicita, ca nimeni sa nu se astepte la mai multe nuclee
+void checkCooperativeTasks(int yylineno)
+{
+    if (cooperativeTasks)
+        return;
+    std::cerr << "[Line " << yylineno << "] Error: spawn runs tasks cooperatively, one at a time on a single "
+              << "thread; pass --cooperative-tasks to use it\n";
+    abortCompilation();
+}
+
+// Ce se pastreaza pentru un task oprit
+struct TaskState
+{
+    std::vector<int>         calls;      // activeCalls al task-ului
+    std::vector<std::string> values;     // valorile variabilelor locale ale acestor functii
+    std::vector<RtString>    texts;
+};
+std::vector<TaskState> taskStates;   // indexat dupa id-ul din scheduler
+
+int findChannel(SymbolId name)
+{
+    for (size_t i = 0; i < channels.size(); i++)
+        if (channels[i].name == name)
+            return static_cast<int>(i);
+    return -1;
+}
+
+// chan TYPE name(capacity); - doar global, in fisierul principal
+void addChannel(SymbolId type, SymbolId name, const ResultAST& capacity, int yylineno)
+{
+    if (currentModule >= 0)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Channel " << symbols.name(name)
+                  << " must be declared in the main file, not in a module\n";
+        abortCompilation();
+    }
+    if (findChannel(name) >= 0 || findVar(name))
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Channel " << symbols.name(name)
+                  << " has already been declared\n";
+        abortCompilation();
+    }
+    int size = (capacity.treeType == Category::NUMBER_INT) ? std::stoi(capacity.resultStr) : 0;
+    if (size < 1 || size > ARRAYMAX)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Incorrect channel capacity.\n";
+        abortCompilation();
+    }
+    checkCapacity(static_cast<int>(channels.size()), "channels", yylineno);
+
+    Channel ch;
+    ch.name     = name;
+    ch.type     = typeFromSymbol(type);
+    ch.capacity = size;
+    channels.push_back(ch);
+
+    std::cout << "[DEBUG] Added channel: " << symbols.name(name) << " of type " << typeToString(ch.type)
+              << " with capacity " << size << "\n";
+}
+
+// c.send(x) / c.recv(v) / c.close(); nodul da bool, funcIndex e indexul canalului
+AST* buildChannelTree(int ch, SymbolId op, std::vector<AST*>* args, int yylineno)
+{
+    const Channel&     c    = channels[ch];
+    const std::string& name = symbols.name(op);
+    size_t expected = (name == "close") ? 0 : 1;
+    if ((name != "send" && name != "recv" && name != "close") || args->size() != expected)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Unknown channel operation " << symbols.name(c.name)
+                  << "." << name << "(); channels support send(value), recv(variable) and close()\n";
+        abortCompilation();
+    }
+    if (expected == 1)
+    {
+        const AST* arg = (*args)[0];
+        if (arg->treeType != c.type.base)
+        {
+            std::cerr << "[Line " << yylineno << "] Error: Channel " << symbols.name(c.name) << " carries "
+                      << typeToString(c.type) << " values, not " << convertEnumToString(arg->treeType) << "\n";
+            abortCompilation();
+        }
+        if (name == "recv" &&
+            (arg->category != Category::IDENTIFIER || (arg->var->type.dim > 0 && !arg->index)))
+        {
+            std::cerr << "[Line " << yylineno << "] Error: " << symbols.name(c.name)
+                      << ".recv() needs a variable or an array element\n";
+            abortCompilation();
+        }
+        if (name == "recv" && arg->var->isConst)
+        {
+            std::cerr << "[Line " << yylineno << "] Error: The value of constant variable "
+                      << symbols.name(arg->var->name) << " cannot be modified\n";
+            abortCompilation();
+        }
+    }
+
+    AST* node = buildTree(symbols.name(c.name) + "." + name, Category::CHANNEL, nullptr, nullptr, yylineno);
+    node->treeType  = Category::NUMBER_BOOL;
+    node->sym       = op;
+    node->funcIndex = ch;
+    node->args      = std::move(*args);
+    delete args;
+    return node;
+}
+
+// spawn EXPR; - doar apeluri de functii / metode
+Stmt* makeSpawnStmt(AST* call, int yylineno)
+{
+    if (call->category != Category::CALL)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: spawn expects a function call\n";
+        abortCompilation();
+    }
+    checkCooperativeTasks(yylineno);
+    spawnUsed = true;
+    return makeStmt(StmtKind::SPAWN, call, yylineno);
+}
+
+// ~~~ Cadrele task-urilor ~~~
+
+int varIndex(const VarSymbol* v);
+
+// Variabilele declarate in corpurile functiilor (cele care trebuie salvate)
+void collectLocals(const std::vector<Stmt*>& block, std::vector<bool>& local)
+{
+    for (const Stmt* st : block)
+    {
+        if (st->kind == StmtKind::DECL)
+            local[varIndex(st->target.var)] = true;
+        collectLocals(st->body, local);
+        collectLocals(st->elseBody, local);
+    }
+}
+
+void collectFrame(const AST* node, const std::vector<bool>& local, std::vector<bool>& seen,
+                  std::vector<VarSymbol*>& frame)
+{
+    if (!node)
+        return;
+    if (node->var && local[varIndex(node->var)] && !seen[varIndex(node->var)])
+    {
+        seen[varIndex(node->var)] = true;
+        frame.push_back(node->var);
+    }
+    collectFrame(node->left, local, seen, frame);
+    collectFrame(node->right, local, seen, frame);
+    collectFrame(node->index, local, seen, frame);
+    for (const AST* arg : node->args)
+        collectFrame(arg, local, seen, frame);
+}
+
+void collectFrame(const std::vector<Stmt*>& block, const std::vector<bool>& local, std::vector<bool>& seen,
+                  std::vector<VarSymbol*>& frame);
+
+void collectFrame(const Stmt* st, const std::vector<bool>& local, std::vector<bool>& seen,
+                  std::vector<VarSymbol*>& frame)
+{
+    if (!st)
+        return;
+    VarSymbol* target = st->target.var;
+    if (target && local[varIndex(target)] && !seen[varIndex(target)])
+    {
+        seen[varIndex(target)] = true;
+        frame.push_back(target);
+    }
+    collectFrame(st->expr, local, seen, frame);
+    collectFrame(st->target.index, local, seen, frame);
+    collectFrame(st->init, local, seen, frame);
+    collectFrame(st->step, local, seen, frame);
+    collectFrame(st->body, local, seen, frame);
+    collectFrame(st->elseBody, local, seen, frame);
+}
+
+void collectFrame(const std::vector<Stmt*>& block, const std::vector<bool>& local, std::vector<bool>& seen,
+                  std::vector<VarSymbol*>& frame)
+{
+    for (const Stmt* st : block)
+        collectFrame(st, local, seen, frame);
+}
+
+// Pentru fiecare functie (si main): parametrii si variabilele locale pe care le
+// foloseste, inclusiv cele ale functiilor copiate in corpul ei de -O1 / -O2
+void computeFrames()
+{
+    std::vector<bool> local(varsNumber, false);
+    for (int i = 0; i < funcNumber; i++)
+    {
+        for (VarSymbol* p : func[i].params)
+            local[varIndex(p)] = true;
+        collectLocals(func[i].body, local);
+    }
+
+    mainFrame     = funcNumber;
+    framesVersion = funcVersion;
+    frameVars.assign(funcNumber + 1, {});
+    for (int i = 0; i <= funcNumber; i++)
+    {
+        std::vector<bool> seen(varsNumber, false);
+        if (i < funcNumber)
+        {
+            for (VarSymbol* p : func[i].params)
+            {
+                seen[varIndex(p)] = true;
+                frameVars[i].push_back(p);
+            }
+        }
+        collectFrame(i < funcNumber ? func[i].body : mainBody, local, seen, frameVars[i]);
+    }
+}
+
+void saveTask(int id)
+{
+    TaskState& state = taskStates[id];
+    state.calls.swap(activeCalls);
+    activeCalls.clear();
+    state.values.clear();
+    state.texts.clear();
+    for (int f : state.calls)
+    {
+        for (const VarSymbol* v : frameVars[f])
+        {
+            state.values.push_back(v->value);
+            state.texts.push_back(v->text);
+        }
+    }
+}
+
+void restoreTask(int id)
+{
+    TaskState& state = taskStates[id];
+    size_t k = 0;
+    for (int f : state.calls)
+    {
+        for (VarSymbol* v : frameVars[f])
+        {
+            v->value = std::move(state.values[k]);
+            v->text  = state.texts[k];
+            k++;
+        }
+    }
+    activeCalls.swap(state.calls);
+    state.calls.clear();
+}
+
+// ~~~ Executia ~~~
+
+void spawnTask(AST* call, int yylineno)
+{
+    if (!scheduler.inTask())
+    {
+        std::cerr << "[Line " << yylineno << "] Error: spawn can only be used while main is running\n";
+        abortCompilation();
+    }
+    if (scheduler.taskCount() - scheduler.finishedCount() >= LENMAX)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Too many tasks (at most " << LENMAX
+                  << " running at the same time).\n";
+        abortCompilation();
+    }
+
+    int funcIndex = call->funcIndex;
+    std::vector<ResultAST> values = evaluateArgs(call->args, yylineno);
+    int id = scheduler.spawn([funcIndex, values] { invokeFunction(funcIndex, values); });
+    taskStates.resize(scheduler.slotCount());
+    std::cout << "[DEBUG] Spawned task " << id << ": " << call->label << "\n";
+}
+
+// Task-ul curent asteapta in coada queue a canalului ch
+void waitOn(std::deque<int>& queue, const Channel& ch, const char* op, int yylineno)
+{
+    if (!scheduler.inTask())
+    {
+        std::cerr << "[Line " << yylineno << "] Error: " << symbols.name(ch.name) << "." << op
+                  << "() would wait forever: no tasks are running\n";
+        abortCompilation();
+    }
+    queue.push_back(scheduler.currentTask());
+    scheduler.block();
+}
+
+void wakeFirst(std::deque<int>& queue)
+{
+    if (queue.empty())
+        return;
+    scheduler.wake(queue.front());
+    queue.pop_front();
+}
+
+ResultAST channelOp(AST* node, int yylineno)
+{
+    Channel& ch = channels[node->funcIndex];
+    const std::string& op = symbols.name(node->sym);
+
+    ResultAST res;
+    res.treeType  = Category::NUMBER_BOOL;
+    res.resultStr = "true";
+
+    if (op == "send")
+    {
+        ResultAST value = evaluateTree(node->args[0], yylineno);
+        while (!ch.closed && static_cast<int>(ch.items.size()) >= ch.capacity)
+            waitOn(ch.senders, ch, "send", yylineno);
+        if (ch.closed)
+        {
+            std::cerr << "[Line " << yylineno << "] Error: Send on closed channel "
+                      << symbols.name(ch.name) << ".\n";
+            abortCompilation();
+        }
+        ch.items.push_back(value);
+        wakeFirst(ch.receivers);
+    }
+    else if (op == "recv")
+    {
+        while (!ch.closed && ch.items.empty())
+            waitOn(ch.receivers, ch, "recv", yylineno);
+        if (ch.items.empty())
+        {
+            res.resultStr = "false";
+            return res;
+        }
+        ResultAST value = ch.items.front();
+        ch.items.pop_front();
+        wakeFirst(ch.senders);
+
+        const AST* target = node->args[0];
+        int index = -1;
+        if (target->indexSafe)
+            index = std::stoi(evaluateTree(target->index, yylineno).resultStr);
+        else if (target->index)
+            index = checkIndex(evaluateTree(target->index, yylineno), yylineno);
+        updateVarValue(*target->var, index, value, yylineno, !target->indexSafe);
+    }
+    else
+    {
+        if (ch.closed)
+        {
+            std::cerr << "[Line " << yylineno << "] Error: Channel " << symbols.name(ch.name)
+                      << " is already closed.\n";
+            abortCompilation();
+        }
+        ch.closed = true;
+        while (!ch.senders.empty())
+            wakeFirst(ch.senders);
+        while (!ch.receivers.empty())
+            wakeFirst(ch.receivers);
+    }
+    return res;
+}
+
+// main ca task; se termina cand nu mai ruleaza niciun task
+void runTasks()
+{
+    if (profiler.enabled)
+    {
+        std::cerr << "Error: --profile does not support programs that use spawn or channels.\n";
+        abortCompilation();
+    }
+
+    computeFrames();
+    scheduler.onSuspend = saveTask;
+    scheduler.onResume  = restoreTask;
+    scheduler.spawn([] {
+        activeCalls.push_back(mainFrame);
+        execBlock(mainBody);
+        returning = false;
+    });
+    taskStates.resize(scheduler.slotCount());
+
+    if (!scheduler.run())
+    {
+        std::cerr << "Error: Deadlock: every unfinished task is waiting on a channel ("
+                  << scheduler.taskCount() - scheduler.finishedCount() << " blocked)\n";
+        for (const Channel& ch : channels)
+        {
+            if (!ch.receivers.empty())
+                std::cerr << "  " << ch.receivers.size() << " waiting to receive from "
+                          << symbols.name(ch.name) << "\n";
+            if (!ch.senders.empty())
+                std::cerr << "  " << ch.senders.size() << " waiting to send to "
+                          << symbols.name(ch.name) << "\n";
+        }
+        abortCompilation();
+    }
+    std::cout << "[DEBUG] Tasks finished: " << scheduler.taskCount() << " tasks, "
+              << scheduler.switchCount() << " context switches\n";
+}
+
+// Executa main (dupa parsare)
+void runMain()
+{
+    if (spawnUsed || !channels.empty())
+    {
+        runTasks();
+        return;
+    }
+
+    if (profiler.enabled)
+    {
+        for (int i = 0; i < funcNumber; i++)
+        {
+            std::string name = symbols.name(func[i].name);
+            if (func[i].domain != SYM_GLOBAL)
+                name = symbols.name(func[i].domain) + "::" + name;
+            profiler.nameFunction(i, name);
+        }
+        profiler.nameFunction(MAIN_PROFILE_ID, "main");
+        profiler.enterFunction(MAIN_PROFILE_ID);
+    }
+
+    execBlock(mainBody);
+    returning = false;
+
+    if (profiler.enabled)
+        profiler.leaveFunction();
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          BUCLE PARALELE (parallel for ... reduce(...))
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// parallel [(static|dynamic[, chunk])] for (i = a; i < b; i = i + c) [reduce(+: s, *: p, min: m, max: M)] { ... }
+// Iteratiile se impart pe fire (parallel.hpp). Interpretorul de arbori nu poate
+// rula pe mai multe fire (tabelele, variabilele si liniile [DEBUG] sunt globale),
+// asa ca un corp paralel se traduce intr-un "kernel": expresii si instructiuni
+// peste valori int / float / bool, cu sloturi proprii fiecarui fir. La parsare se
+// verifica faptul ca iteratiile nu depind una de alta:
+//  - antetul are forma de mai sus (sau descrescator: > / >= cu i = i - c), c e un
+//    literal > 0, iar limita nu apeleaza functii si nu foloseste nimic scris in corp;
+//  - corpul are doar declaratii scalare, atribuiri, if, while, do-while si for,
+//    fara apeluri, canale, string-uri, char-uri si atribute de obiecte;
+//  - un array scris in corp se foloseste doar ca a[i] (i = contorul);
+//  - o variabila scalara scrisa in corp e declarata direct in corp (fiecare
+//    iteratie are copia ei) sau e in reduce(...), unde se actualizeaza doar ca
+//    s = s + e / p = p * e, respectiv if (e < m) { m = e; } (min) si
+//    if (e > M) { M = e; } (max), cu e fara variabila redusa.
+// Rezultatele sunt cele ale buclei for obisnuite: intregii fac wrap-around,
+// floatii se rotunjesc la 6 zecimale dupa fiecare operatie, iar o eroare se
+// raporteaza pentru prima iteratie (in ordine) care o produce, cu efectele
+// iteratiilor dinaintea ei deja scrise in variabile si array-uri. Exceptii: o reducere
+// + / * pe float aduna in alta ordine (ultimele zecimale pot diferi) si corpul nu
+// scrie linii [DEBUG]. Dupa bucla, contorul are valoarea finala, iar variabilele
+// declarate in corp pe cele din ultima iteratie.
+
+int parallelThreads = 0;   // --threads=N; 0 = cate fire hardware are masina
+
+// Valoarea unui int / bool (i) sau float (f) in kernel
+struct KValue
+{
+    union
+    {
+        std::int32_t i = 0;
+        float        f;
+    };
+    bool zeroText = false;   // float cu textul "0" (valoarea implicita), nu "0.000000"
+};
+
+enum class KOp { CONST, SCALAR, ELEM, ADD, SUB, MUL, DIV, MOD, LT, GT, LE, GE, EQ, NE, AND, OR, NOT };
+
+struct KExpr
+{
+    KOp      op;
+    Category type;                       // tipul rezultatului
+    Category operand = Category::OTHER;  // comparatii, &&, ||, !: tipul operanzilor
+    KValue   value;                      // CONST
+    int      slot = -1;                  // SCALAR: slotul; ELEM: array-ul
+    int      left = -1, right = -1;      // ELEM: left e indexul
+};
+
+enum class KStmtKind { SET, SET_ELEM, IF, WHILE, DO_WHILE, FOR };
+
+struct KStmt
+{
+    KStmtKind        kind;
+    int              line;
+    int              slot  = -1;         // SET: slotul; SET_ELEM: array-ul
+    int              index = -1;         // SET_ELEM: expresia indexului
+    int              expr  = -1;         // valoarea / conditia
+    int              init  = -1, step = -1;
+    std::vector<int> body, elseBody;
+};
+
+// Eroare de executie intr-un fir; mesajul se afiseaza din firul principal
+struct KernelError
+{
+    int         line;
+    const char* message;
+};
+
+// Valorile array-urilor folosite, comune tuturor firelor (fiecare iteratie scrie alt element)
+struct KArrays
+{
+    std::vector<std::vector<KValue>> values;
+    std::vector<std::vector<char>>   changed;   // elementele scrise, pt. array-urile scrise
+};
+
+// Ca ftoaCustom urmat de std::stof: valoarea pe care o vede urmatoarea operatie
+float roundFloat(float value)
+{
+    char digits[64];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value, std::chars_format::fixed, 6);
+    float rounded = 0.0f;
+    std::from_chars(digits, res.ptr, rounded);
+    return rounded;
+}
+
+// Operatiile aritmetice din evaluateTree (intArithmetic / floatArithmetic)
+KValue kernelArithmetic(KOp op, Category type, const KValue& l, const KValue& r, int line)
+{
+    char symbol = (op == KOp::ADD) ? '+' :
+                  (op == KOp::SUB) ? '-' :
+                  (op == KOp::MUL) ? '*' :
+                  (op == KOp::DIV) ? '/' : '%';
+
+    KValue res;
+    bool ok = (type == Category::NUMBER_FLOAT) ? floatArithmetic(symbol, l.f, r.f, res.f)
+                                               : intArithmetic(symbol, l.i, r.i, res.i);
+    if (!ok)
+        throw KernelError{line, "Division by zero is not possible."};
+    if (type == Category::NUMBER_FLOAT)
+        res.f = roundFloat(res.f);
+    return res;
+}
+
+// Ca compareValues (bool: false < true)
+int kernelCompare(const KValue& l, const KValue& r, Category type)
+{
+    if (type == Category::NUMBER_FLOAT)
+        return (l.f > r.f) - (l.f < r.f);
+    return (l.i > r.i) - (l.i < r.i);
+}
+
+bool kernelTruth(const KValue& v, Category type)
+{
+    return (type == Category::NUMBER_FLOAT) ? v.f != 0.0f : v.i != 0;
+}
+
+struct Kernel
+{
+    std::vector<KExpr>      exprs;
+    std::vector<KStmt>      stmts;
+    std::vector<int>        body;
+    std::vector<VarSymbol*> slotVars;       // variabila fiecarui slot
+    std::vector<VarSymbol*> arrayVars;
+    std::vector<bool>       arrayWritten;
+    std::vector<int>        locals;         // sloturile variabilelor declarate in corp
+    std::vector<int>        reductions;     // slotul fiecarei variabile din reduce(...)
+    int                     counter = -1;   // slotul contorului
+
+    // Un index negativ e eroare inainte de a evalua valoarea (ca checkIndex)
+    int index(int e, int line, KValue* slots, KArrays& arrays) const
+    {
+        int i = eval(e, line, slots, arrays).i;
+        if (i < 0)
+            throw KernelError{line, "Invalid vector index"};
+        return i;
+    }
+
+    KValue eval(int e, int line, KValue* slots, KArrays& arrays) const
+    {
+#ifdef LFAC_FUZZ
+        if (--fuzzBudget < 0)
+            throw KernelError{line, "Evaluation budget exceeded."};
+#endif
+        const KExpr& x = exprs[e];
+        KValue res;
+        switch (x.op)
+        {
+            case KOp::CONST:
+                return x.value;
+            case KOp::SCALAR:
+                return slots[x.slot];
+            case KOp::ELEM:
+            {
+                int i = index(x.left, line, slots, arrays);
+                const std::vector<KValue>& a = arrays.values[x.slot];
+                if (i >= static_cast<int>(a.size()))
+                    throw KernelError{line, "Invalid vector index"};
+                return a[i];
+            }
+            case KOp::NOT:
+                res.i = !kernelTruth(eval(x.left, line, slots, arrays), x.operand);
+                return res;
+            case KOp::AND:
+                res.i = kernelTruth(eval(x.left, line, slots, arrays), x.operand) &&
+                        kernelTruth(eval(x.right, line, slots, arrays), x.operand);
+                return res;
+            case KOp::OR:
+                res.i = kernelTruth(eval(x.left, line, slots, arrays), x.operand) ||
+                        kernelTruth(eval(x.right, line, slots, arrays), x.operand);
+                return res;
+            case KOp::LT: case KOp::GT: case KOp::LE: case KOp::GE: case KOp::EQ: case KOp::NE:
+            {
+                KValue l = eval(x.left, line, slots, arrays);
+                int cmp  = kernelCompare(l, eval(x.right, line, slots, arrays), x.operand);
+                res.i = (x.op == KOp::LT) ? cmp <  0 :
+                        (x.op == KOp::GT) ? cmp >  0 :
+                        (x.op == KOp::LE) ? cmp <= 0 :
+                        (x.op == KOp::GE) ? cmp >= 0 :
+                        (x.op == KOp::EQ) ? cmp == 0 : cmp != 0;
+                return res;
+            }
+            default:
+            {
+                KValue l = eval(x.left, line, slots, arrays);
+                return kernelArithmetic(x.op, x.type, l, eval(x.right, line, slots, arrays), line);
+            }
+        }
+    }
+
+    void exec(int s, KValue* slots, KArrays& arrays) const
+    {
+        const KStmt& st = stmts[s];
+        switch (st.kind)
+        {
+            case KStmtKind::SET:
+                slots[st.slot] = eval(st.expr, st.line, slots, arrays);
+                break;
+            case KStmtKind::SET_ELEM:
+            {
+                int i = index(st.index, st.line, slots, arrays);
+                KValue value = eval(st.expr, st.line, slots, arrays);
+                std::vector<KValue>& a = arrays.values[st.slot];
+                if (i >= static_cast<int>(a.size()))
+                    throw KernelError{st.line, "Invalid vector index"};
+                a[i] = value;
+                arrays.changed[st.slot][i] = 1;
+                break;
+            }
+            case KStmtKind::IF:
+                if (truth(st.expr, st.line, slots, arrays))
+                    run(st.body, slots, arrays);
+                else
+                    run(st.elseBody, slots, arrays);
+                break;
+            case KStmtKind::WHILE:
+                while (truth(st.expr, st.line, slots, arrays))
+                    run(st.body, slots, arrays);
+                break;
+            case KStmtKind::DO_WHILE:
+                do
+                {
+                    run(st.body, slots, arrays);
+                } while (truth(st.expr, st.line, slots, arrays));
+                break;
+            case KStmtKind::FOR:
+                for (exec(st.init, slots, arrays); truth(st.expr, st.line, slots, arrays);
+                     exec(st.step, slots, arrays))
+                    run(st.body, slots, arrays);
+                break;
+        }
+    }
+
+    bool truth(int e, int line, KValue* slots, KArrays& arrays) const
+    {
+        return kernelTruth(eval(e, line, slots, arrays), exprs[e].type);
+    }
+
+    void run(const std::vector<int>& block, KValue* slots, KArrays& arrays) const
+    {
+        for (int s : block)
+            exec(s, slots, arrays);
+    }
+};
+
+int countUses(const AST* node, const VarSymbol* v);
+
+// Traducerea corpului in kernel, cu verificarile de mai sus (eroare de compilare)
+struct KernelBuilder
+{
+    Kernel&                 k;
+    const Stmt*             loop;
+    VarSymbol*              counter = nullptr;
+    std::vector<VarSymbol*> locals;    // declarate direct in corp
+    std::vector<VarSymbol*> written;   // array-urile scrise in corp
+
+    KernelBuilder(Kernel& k, const Stmt* loop) : k(k), loop(loop) {}
+
+    [[noreturn]] void fail(int line, const std::string& what)
+    {
+        std::cerr << "[Line " << line << "] Error: parallel for: " << what << "\n";
+        abortCompilation();
+    }
+
+    static bool contains(const std::vector<VarSymbol*>& list, const VarSymbol* v)
+    {
+        return std::find(list.begin(), list.end(), v) != list.end();
+    }
+
+    const Reduction* reductionOf(const VarSymbol* v) const
+    {
+        for (const Reduction& r : loop->parallel.reductions)
+            if (r.var == v)
+                return &r;
+        return nullptr;
+    }
+
+    // Nodul e chiar variabila redusa (fara index)
+    const Reduction* reductionNode(const AST* node) const
+    {
+        if (!node || node->category != Category::IDENTIFIER || node->index || node->object)
+            return nullptr;
+        return reductionOf(node->var);
+    }
+
+    std::string usage(const Reduction& r) const
+    {
+        std::string name = symbols.name(r.var->name);
+        if (r.op == '+' || r.op == '*')
+            return "reduction variable " + name + " can only be updated as " + name + " = " + name + " " +
+                   r.op + " <expression>";
+        return "reduction variable " + name + " can only be updated as if (<expression> " + r.op + " " +
+               name + ") { " + name + " = <expression>; }";
+    }
+
+    int slotOf(VarSymbol* v)
+    {
+        for (size_t i = 0; i < k.slotVars.size(); i++)
+            if (k.slotVars[i] == v)
+                return static_cast<int>(i);
+        k.slotVars.push_back(v);
+        return static_cast<int>(k.slotVars.size()) - 1;
+    }
+
+    int arrayOf(VarSymbol* v)
+    {
+        for (size_t i = 0; i < k.arrayVars.size(); i++)
+            if (k.arrayVars[i] == v)
+                return static_cast<int>(i);
+        k.arrayVars.push_back(v);
+        k.arrayWritten.push_back(contains(written, v));
+        return static_cast<int>(k.arrayVars.size()) - 1;
+    }
+
+    int add(const KExpr& x)
+    {
+        k.exprs.push_back(x);
+        return static_cast<int>(k.exprs.size()) - 1;
+    }
+
+    int add(KStmt st)
+    {
+        k.stmts.push_back(std::move(st));
+        return static_cast<int>(k.stmts.size()) - 1;
+    }
+
+    void checkType(const VarSymbol* v, int line)
+    {
+        Category base = v->type.base;
+        if (base != Category::NUMBER_INT && base != Category::NUMBER_FLOAT && base != Category::NUMBER_BOOL)
+            fail(line, "variable " + symbols.name(v->name) + " has type " + typeToString(v->type) +
+                       "; only int, float and bool values can be used in the body");
+    }
+
+    // Contorul, i < b (<=, > sau >=) si i = i + c (sau - c)
+    void header()
+    {
+        const Stmt* init = loop->init;
+        const Stmt* step = loop->step;
+        const AST*  cond = loop->expr;
+        const char* shape = "the loop must look like for (i = a; i < b; i = i + c), or count down with "
+                            "> / >= and i = i - c, where c is an int literal > 0";
+        if (!init || init->kind != StmtKind::ASSIGN || init->target.index || init->target.object)
+            fail(loop->line, shape);
+        counter = init->target.var;
+        if (counter->type.base != Category::NUMBER_INT || counter->type.dim)
+            fail(loop->line, "the counter " + symbols.name(counter->name) + " must be an int variable");
+        if (reductionOf(counter))
+            fail(loop->line, "the counter " + symbols.name(counter->name) + " cannot be in reduce(...)");
+
+        auto isCounter = [this](const AST* node) {
+            return node && node->category == Category::IDENTIFIER && node->var == counter &&
+                   !node->index && !node->object;
+        };
+        const AST* inc = step ? step->expr : nullptr;
+        if (!cond || cond->category != Category::NUMBER_BOOL || !cond->right || !isCounter(cond->left) ||
+            !step || step->kind != StmtKind::ASSIGN || step->target.var != counter || step->target.index ||
+            !inc || inc->category != Category::OPERATOR || !isCounter(inc->left) || !inc->right ||
+            inc->right->category != Category::NUMBER_INT || inc->right->left || std::stoll(inc->right->label) <= 0)
+            fail(loop->line, shape);
+        const std::string& op = cond->label;
+        bool up = inc->label == "+" && (op == "<" || op == "<=");
+        bool down = inc->label == "-" && (op == ">" || op == ">=");
+        if (!up && !down)
+            fail(loop->line, shape);
+    }
+
+    // Limita se evalueaza o singura data, deci nu are voie sa depinda de corp
+    void bound()
+    {
+        const AST* limit = loop->expr->right;
+        if (containsCall(limit))
+            fail(loop->line, "the loop bound cannot call functions or use channels");
+        std::vector<VarSymbol*> changing = locals;
+        changing.insert(changing.end(), written.begin(), written.end());
+        changing.push_back(counter);
+        for (const Reduction& r : loop->parallel.reductions)
+            changing.push_back(r.var);
+        for (const VarSymbol* v : changing)
+            if (countUses(limit, v))
+                fail(loop->line, "the loop bound cannot use " + symbols.name(v->name) +
+                                 ", which changes inside the loop");
+    }
+
+    // Array-urile tinta ale atribuirilor (si in for-urile imbricate)
+    void collectWritten(const std::vector<Stmt*>& block)
+    {
+        for (const Stmt* st : block)
+        {
+            for (const Stmt* s : {st, static_cast<const Stmt*>(st->init), static_cast<const Stmt*>(st->step)})
+                if (s && s->kind == StmtKind::ASSIGN && s->target.index && !contains(written, s->target.var))
+                    written.push_back(s->target.var);
+            collectWritten(st->body);
+            collectWritten(st->elseBody);
+        }
+    }
+
+    int arrayIndex(VarSymbol* v, const AST* index, int line)
+    {
+        std::string name = symbols.name(v->name);
+        if (contains(written, v) &&
+            (index->category != Category::IDENTIFIER || index->var != counter || index->index || index->object))
+            fail(line, "array " + name + " is written in the body, so it can only be used as " + name + "[" +
+                       symbols.name(counter->name) + "]");
+        if (index->treeType != Category::NUMBER_INT)
+            fail(line, "the index of array " + name + " must be an int");
+        return expr(index, line);
+    }
+
+    int variable(const AST* node, int line)
+    {
+        VarSymbol* v = node->var;
+        std::string name = symbols.name(v->name);
+        if (node->object)
+            fail(line, "object fields cannot be used in the body");
+        checkType(v, line);
+
+        KExpr x;
+        x.type = node->treeType;
+        if (v->type.dim > 0)
+        {
+            if (!node->index)
+                fail(line, "array " + name + " can only be used element by element");
+            x.op   = KOp::ELEM;
+            x.slot = arrayOf(v);
+            x.left = arrayIndex(v, node->index, line);
+            return add(x);
+        }
+        if (node->index)
+            fail(line, name + " is not an array");
+        if (const Reduction* r = reductionOf(v))
+            fail(line, usage(*r));
+        x.op   = KOp::SCALAR;
+        x.slot = slotOf(v);
+        return add(x);
+    }
+
+    static KValue literal(const std::string& label, Category type)
+    {
+        KValue v;
+        if (type == Category::NUMBER_FLOAT)
+        {
+            v.f        = std::stof(label);
+            v.zeroText = label == "0";
+        }
+        else if (type == Category::NUMBER_BOOL)
+            v.i = label == "true";
+        else
+            v.i = std::stoi(label);
+        return v;
+    }
+
+    int expr(const AST* node, int line)
+    {
+        if (node->category == Category::CALL || node->category == Category::CHANNEL)
+            fail(line, "function calls and channel operations are not allowed in the body");
+        Category type = node->treeType;
+        if (type != Category::NUMBER_INT && type != Category::NUMBER_FLOAT && type != Category::NUMBER_BOOL)
+            fail(line, "only int, float and bool values can be used in the body (found " +
+                       convertEnumToString(type) + ")");
+
+        if (!node->left)
+        {
+            if (node->category == Category::IDENTIFIER)
+                return variable(node, line);
+            KExpr x;
+            x.op    = KOp::CONST;
+            x.type  = type;
+            x.value = literal(node->label, type);
+            return add(x);
+        }
+
+        KExpr x;
+        x.type    = type;
+        x.operand = node->left->treeType;
+        const std::string& op = node->label;
+        if (node->category == Category::NUMBER_BOOL)
+        {
+            x.op = (op == "!")  ? KOp::NOT : (op == "&&") ? KOp::AND : (op == "||") ? KOp::OR :
+                   (op == "<")  ? KOp::LT  : (op == ">")  ? KOp::GT  : (op == "<=") ? KOp::LE :
+                   (op == ">=") ? KOp::GE  : (op == "==") ? KOp::EQ  : KOp::NE;
+        }
+        else
+        {
+            if (type == Category::NUMBER_BOOL)
+                fail(line, "operator " + op + " is not defined for bool values");
+            x.op = (op == "+") ? KOp::ADD : (op == "-") ? KOp::SUB : (op == "*") ? KOp::MUL :
+                   (op == "/") ? KOp::DIV : KOp::MOD;
+        }
+        x.left = expr(node->left, line);
+        if (node->right)
+            x.right = expr(node->right, line);
+        return add(x);
+    }
+
+    static bool sameTree(const AST* a, const AST* b)
+    {
+        if (!a || !b)
+            return a == b;
+        return a->category == b->category && a->label == b->label && a->var == b->var &&
+               a->object == b->object && a->args.empty() && b->args.empty() &&
+               sameTree(a->left, b->left) && sameTree(a->right, b->right) && sameTree(a->index, b->index);
+    }
+
+    // s = s + e / p = p * e (sau e + s, e * p)
+    int accumulate(const Stmt* st, const Reduction& r)
+    {
+        const AST* value = st->expr;
+        bool shape = (r.op == '+' || r.op == '*') && value->category == Category::OPERATOR &&
+                     value->label.size() == 1 && value->label[0] == r.op && value->right;
+        const AST* other = nullptr;
+        if (shape && reductionNode(value->left) == &r)
+            other = value->right;
+        else if (shape && reductionNode(value->right) == &r)
+            other = value->left;
+        if (!other)
+            fail(st->line, usage(r));
+
+        KExpr self;
+        self.op   = KOp::SCALAR;
+        self.type = r.var->type.base;
+        self.slot = slotOf(r.var);
+        KExpr x;
+        x.op    = (r.op == '+') ? KOp::ADD : KOp::MUL;
+        x.type  = self.type;
+        x.left  = add(self);
+        x.right = expr(other, st->line);   // eroare daca other foloseste variabila
+
+        KStmt set;
+        set.kind = KStmtKind::SET;
+        set.line = st->line;
+        set.slot = self.slot;
+        set.expr = add(x);
+        return add(std::move(set));
+    }
+
+    // if (e < m) { m = e; } pt. min(m) si if (e > m) { m = e; } pt. max(m); merg si <=, >=
+    // sau m in stanga (m > e). -1 daca conditia nu compara o variabila redusa.
+    int minMax(const Stmt* st)
+    {
+        const AST* cond = st->expr;
+        if (cond->category != Category::NUMBER_BOOL || !cond->left || !cond->right)
+            return -1;
+        const std::string& op = cond->label;
+        bool less = op == "<" || op == "<=";
+        if (!less && op != ">" && op != ">=")
+            return -1;
+        const AST*       e = cond->left;
+        const Reduction* r = reductionNode(cond->right);
+        bool reducedLeft = false;
+        if (!r)
+        {
+            r = reductionNode(cond->left);
+            e = cond->right;
+            reducedLeft = true;
+        }
+        if (!r)
+            return -1;
+
+        char kind = (less != reducedLeft) ? '<' : '>';
+        const Stmt* update = (st->body.size() == 1 && st->elseBody.empty()) ? st->body[0] : nullptr;
+        if (r->op != kind || !update || update->kind != StmtKind::ASSIGN || update->target.var != r->var ||
+            update->target.index || update->target.object || !sameTree(update->expr, e))
+            fail(st->line, usage(*r));
+
+        KExpr self;
+        self.op   = KOp::SCALAR;
+        self.type = r->var->type.base;
+        self.slot = slotOf(r->var);
+        int selfExpr  = add(self);
+        int valueExpr = expr(e, st->line);
+        KExpr test;
+        test.op      = (op == "<") ? KOp::LT : (op == "<=") ? KOp::LE : (op == ">") ? KOp::GT : KOp::GE;
+        test.type    = Category::NUMBER_BOOL;
+        test.operand = self.type;
+        test.left    = reducedLeft ? selfExpr : valueExpr;
+        test.right   = reducedLeft ? valueExpr : selfExpr;
+
+        KStmt set;
+        set.kind = KStmtKind::SET;
+        set.line = update->line;
+        set.slot = self.slot;
+        set.expr = expr(update->expr, update->line);
+        KStmt branch;
+        branch.kind = KStmtKind::IF;
+        branch.line = st->line;
+        branch.expr = add(test);
+        branch.body.push_back(add(std::move(set)));
+        return add(std::move(branch));
+    }
+
+    int assign(const Stmt* st)
+    {
+        const LValue& t = st->target;
+        VarSymbol*    v = t.var;
+        std::string name = symbols.name(v->name);
+        if (t.object)
+            fail(st->line, "object fields cannot be assigned in the body");
+        checkType(v, st->line);
+
+        KStmt set;
+        set.line = st->line;
+        if (t.index)
+        {
+            if (v->type.dim == 0)
+                fail(st->line, name + " is not an array");
+            set.kind  = KStmtKind::SET_ELEM;
+            set.slot  = arrayOf(v);
+            set.index = arrayIndex(v, t.index, st->line);
+            set.expr  = expr(st->expr, st->line);
+            return add(std::move(set));
+        }
+        if (v->type.dim > 0)
+            fail(st->line, "array " + name + " can only be assigned element by element");
+        if (v == counter)
+            fail(st->line, "the loop counter " + name + " cannot be assigned in the body");
+        if (const Reduction* r = reductionOf(v))
+            return accumulate(st, *r);
+        if (!contains(locals, v))
+            fail(st->line, "variable " + name + " is shared by all iterations; declare it in the loop body "
+                           "or list it in reduce(...)");
+        set.kind = KStmtKind::SET;
+        set.slot = slotOf(v);
+        set.expr = expr(st->expr, st->line);
+        return add(std::move(set));
+    }
+
+    std::vector<int> block(const std::vector<Stmt*>& body, bool top)
+    {
+        std::vector<int> out;
+        for (const Stmt* st : body)
+            out.push_back(stmt(st, top));
+        return out;
+    }
+
+    int stmt(const Stmt* st, bool top)
+    {
+        KStmt ks;
+        ks.line = st->line;
+        switch (st->kind)
+        {
+            case StmtKind::DECL:
+            {
+                VarSymbol* v = st->target.var;
+                std::string name = symbols.name(v->name);
+                if (!top)
+                    fail(st->line, "declare " + name + " directly in the loop body, not in a nested block");
+                if (v->type.dim > 0)
+                    fail(st->line, "arrays cannot be declared in the body");
+                checkType(v, st->line);
+                if (st->expr && st->expr->treeType != v->type.base)
+                    fail(st->line, "the initial value of " + name + " must have type " + typeToString(v->type));
+                ks.kind = KStmtKind::SET;
+                ks.slot = slotOf(v);
+                if (st->expr)
+                {
+                    ks.expr = expr(st->expr, st->line);
+                }
+                else
+                {
+                    KExpr zero;
+                    zero.op    = KOp::CONST;
+                    zero.type  = v->type.base;
+                    zero.value = literal(defaultValue(v->type).resultStr, v->type.base);
+                    ks.expr    = add(zero);
+                }
+                return add(std::move(ks));
+            }
+            case StmtKind::ASSIGN:
+                return assign(st);
+            case StmtKind::IF:
+            {
+                int special = minMax(st);
+                if (special >= 0)
+                    return special;
+                ks.kind     = KStmtKind::IF;
+                ks.expr     = expr(st->expr, st->line);
+                ks.body     = block(st->body, false);
+                ks.elseBody = block(st->elseBody, false);
+                return add(std::move(ks));
+            }
+            case StmtKind::WHILE:
+            case StmtKind::DO_WHILE:
+                ks.kind = (st->kind == StmtKind::WHILE) ? KStmtKind::WHILE : KStmtKind::DO_WHILE;
+                ks.expr = expr(st->expr, st->line);
+                ks.body = block(st->body, false);
+                return add(std::move(ks));
+            case StmtKind::FOR:
+                ks.kind = KStmtKind::FOR;
+                ks.init = stmt(st->init, false);
+                ks.expr = expr(st->expr, st->line);
+                ks.step = stmt(st->step, false);
+                ks.body = block(st->body, false);
+                return add(std::move(ks));
+            case StmtKind::PARALLEL_FOR:
+                fail(st->line, "parallel loops cannot be nested");
+            default:
+                fail(st->line, "only declarations, assignments, if, while, do-while and for are allowed "
+                               "in the body (no function calls, Print, TypeOf, return or spawn)");
+        }
+    }
+};
+
+std::unique_ptr<Kernel> buildKernel(const Stmt* loop)
+{
+    auto kernel = std::make_unique<Kernel>();
+    KernelBuilder b(*kernel, loop);
+    b.header();
+    for (const Stmt* st : loop->body)
+        if (st->kind == StmtKind::DECL)
+            b.locals.push_back(st->target.var);
+    b.collectWritten(loop->body);
+    b.bound();
+
+    kernel->counter = b.slotOf(b.counter);
+    for (const Reduction& r : loop->parallel.reductions)
+        kernel->reductions.push_back(b.slotOf(r.var));
+    for (VarSymbol* v : b.locals)
+        kernel->locals.push_back(b.slotOf(v));
+    kernel->body = b.block(loop->body, true);
+    return kernel;
+}
+
+// ~~~ Constructia (din parser) ~~~
+
+// parallel(static) / parallel(dynamic)
+void setSchedule(SymbolId kind, int yylineno)
+{
+    const std::string& name = symbols.name(kind);
+    if (name != "static" && name != "dynamic")
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Unknown schedule " << name
+                  << "; use parallel(static) or parallel(dynamic), optionally with a chunk size\n";
+        abortCompilation();
+    }
+    parallelSpec.dynamic = name == "dynamic";
+}
+
+// parallel(static, 8): iteratii luate odata de un fir
+void setChunk(int chunk, int yylineno)
+{
+    if (chunk < 1 || chunk > ARRAYMAX)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Incorrect chunk size.\n";
+        abortCompilation();
+    }
+    parallelSpec.chunk = chunk;
+}
+
+// op: '+', '*' sau numele min / max
+void addReduction(char op, SymbolId name, int yylineno)
+{
+    VarSymbol* v = findVar(name);
+    if (!v)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Undeclared variable " << symbols.name(name)
+                  << " used in reduce(...)\n";
+        abortCompilation();
+    }
+    if (v->isConst)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: The value of constant variable " << symbols.name(name)
+                  << " cannot be modified\n";
+        abortCompilation();
+    }
+    if (v->type.dim || (v->type.base != Category::NUMBER_INT && v->type.base != Category::NUMBER_FLOAT))
+    {
+        std::cerr << "[Line " << yylineno << "] Error: reduce(...) needs int or float variables, not "
+                  << typeToString(v->type) << " " << symbols.name(name) << "\n";
+        abortCompilation();
+    }
+    for (const Reduction& r : parallelSpec.reductions)
+    {
+        if (r.var == v)
+        {
+            std::cerr << "[Line " << yylineno << "] Error: " << symbols.name(name)
+                      << " appears twice in reduce(...)\n";
+            abortCompilation();
+        }
+    }
+    parallelSpec.reductions.push_back({op, v});
+}
+
+char reductionOp(SymbolId name, int yylineno)
+{
+    const std::string& text = symbols.name(name);
+    if (text != "min" && text != "max")
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Unknown reduction " << text
+                  << "; reduce(...) supports +, *, min and max\n";
+        abortCompilation();
+    }
+    return (text == "min") ? '<' : '>';
+}
+
+// Antetul (fara corp): clauzele parsate trec in instructiune
+Stmt* makeParallelForStmt(Stmt* init, AST* cond, Stmt* step, int yylineno)
+{
+    Stmt* st = makeStmt(StmtKind::PARALLEL_FOR, cond, yylineno);
+    st->init     = init;
+    st->step     = step;
+    st->parallel = parallelSpec;
+    parallelSpec = ParallelSpec();
+    return st;
+}
+
+// Dupa parsarea corpului: erorile se raporteaza acum, kernel-ul se construieste la executie
+void checkParallelFor(const Stmt* st)
+{
+    buildKernel(st);
+}
+
+// ~~~ Executia ~~~
+
+std::unordered_map<const Stmt*, std::unique_ptr<Kernel>> kernels;   // dupa -O si --prune, la prima executie
+
+int parallelThreadCount()
+{
+#ifdef LFAC_FUZZ
+    return 1;   // fuzzBudget e al firului principal
+#else
+    if (parallelThreads > 0)
+        return parallelThreads;
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+#endif
+}
+
+KValue decodeValue(const std::string& text, Category type)
+{
+    KValue v;
+    if (type == Category::NUMBER_FLOAT)
+    {
+        v.f        = std::stof(text);
+        v.zeroText = text == "0";
+    }
+    else if (type == Category::NUMBER_BOOL)
+        v.i = text == "true";
+    else
+        v.i = std::stoi(text);
+    return v;
+}
+
+std::string encodeValue(const KValue& v, Category type)
+{
+    if (type == Category::NUMBER_FLOAT)
+        return v.zeroText ? "0" : ftoaCustom(v.f);
+    if (type == Category::NUMBER_BOOL)
+        return v.i ? "true" : "false";
+    return itoaCustom(v.i);
+}
+
+std::vector<std::string_view> splitElements(const std::string& text)
+{
+    std::vector<std::string_view> elements;
+    std::size_t start = 0;
+    while (true)
+    {
+        std::size_t pos = text.find(' ', start);
+        elements.emplace_back(text.data() + start, (pos == std::string::npos ? text.size() : pos) - start);
+        if (pos == std::string::npos)
+            return elements;
+        start = pos + 1;
+    }
+}
+
+// Valoarea de inceput a unei variabile din reduce(...) in firele 1, 2, ..; firul 0 porneste
+// de la valoarea variabilei, deci cu un singur fir rezultatul e exact cel al buclei for.
+// Pentru + si * pe float, zeroText marcheaza identitatea neatinsa: un fir care nu a
+// actualizat variabila nu schimba nici textul ei.
+KValue reductionStart(char op, const KValue& original, Category type)
+{
+    KValue v;
+    if (op == '<' || op == '>')
+        return original;
+    if (type == Category::NUMBER_FLOAT)
+    {
+        v.f        = (op == '*') ? 1.0f : 0.0f;
+        v.zeroText = true;
+    }
+    else
+        v.i = (op == '*') ? 1 : 0;
+    return v;
+}
+
+KValue reductionCombine(char op, Category type, const KValue& total, const KValue& part)
+{
+    if (op == '<')
+        return kernelCompare(part, total, type) < 0 ? part : total;
+    if (op == '>')
+        return kernelCompare(part, total, type) > 0 ? part : total;
+    if (type == Category::NUMBER_FLOAT && part.zeroText)
+        return total;
+    return kernelArithmetic(op == '+' ? KOp::ADD : KOp::MUL, type, total, part, 0);
+}
+
+void runParallelFor(Stmt* st)
+{
+    auto found = kernels.find(st);
+    if (found == kernels.end())
+        found = kernels.emplace(st, buildKernel(st)).first;
+    const Kernel& k = *found->second;
+    auto started = std::chrono::steady_clock::now();
+
+    // antetul, ca la for: i = a; limita se evalueaza o data (nu depinde de corp)
+    execStmt(st->init);
+    VarSymbol& counter = *st->init->target.var;
+    long long first = std::stoi(counter.value);
+    long long bound = std::stoi(evaluateTree(st->expr->right, st->line).resultStr);
+    long long step  = std::stoll(st->step->expr->right->label);
+    bool      down  = st->step->expr->label == "-";
+    bool      strict = st->expr->label == "<" || st->expr->label == ">";
+    long long span  = down ? first - bound : bound - first;
+    long long count = strict ? (span > 0 ? (span + step - 1) / step : 0) : (span >= 0 ? span / step + 1 : 0);
+    long long last  = down ? first - count * step : first + count * step;
+    if (last < INT32_MIN || last > INT32_MAX)
+    {
+        std::cerr << "[Line " << st->line << "] Error: The counter of the parallel loop overflows int.\n";
+        abortCompilation();
+    }
+
+    auto counterAt = [&](long long n)
+    {
+        return static_cast<std::int32_t>(down ? first - n * step : first + n * step);
+    };
+
+    std::vector<KValue> initial(k.slotVars.size());
+    for (std::size_t i = 0; i < initial.size(); i++)
+        initial[i] = decodeValue(k.slotVars[i]->value, k.slotVars[i]->type.base);
+    auto loadArrays = [&k](KArrays& arrays)
+    {
+        arrays.values.assign(k.arrayVars.size(), {});
+        arrays.changed.assign(k.arrayVars.size(), {});
+        for (std::size_t a = 0; a < k.arrayVars.size(); a++)
+        {
+            const VarSymbol& v = *k.arrayVars[a];
+            std::vector<std::string_view> elements = splitElements(v.value);
+            arrays.values[a].resize(v.type.dim);
+            for (int j = 0; j < v.type.dim && j < static_cast<int>(elements.size()); j++)
+                arrays.values[a][j] = decodeValue(std::string(elements[j]), v.type.base);
+            if (k.arrayWritten[a])
+                arrays.changed[a].assign(v.type.dim, 0);
+        }
+    };
+    KArrays arrays;
+    loadArrays(arrays);
+
+    ParallelRange range;
+    range.count   = count;
+    range.threads = std::min(parallelThreadCount(), LENMAX);
+    range.dynamic = st->parallel.dynamic;
+    range.chunk   = st->parallel.chunk;
+    int used = range.threadCount();
+
+    std::vector<std::vector<KValue>> slots(used, initial);
+    for (std::size_t r = 0; r < k.reductions.size(); r++)
+    {
+        int slot = k.reductions[r];
+        for (int t = 1; t < used; t++)
+            slots[t][slot] = reductionStart(st->parallel.reductions[r].op, initial[slot],
+                                            k.slotVars[slot]->type.base);
+    }
+
+    // Iteratiile de dupa una care a dat eroare nu mai conteaza; cele dinaintea ei ruleaza
+    // toate, deci failedAt ajunge prima iteratie cu eroare, ca in bucla obisnuita
+    std::vector<KValue>    lastSlots;
+    std::atomic<long long> failedAt{count};
+    std::mutex             failureLock;
+    KernelError            failure{0, nullptr};
+
+    range.run([&](int t, long long begin, long long end)
+    {
+        std::vector<KValue>& s = slots[t];
+        long long n = begin;
+        try
+        {
+            for (; n < end && n < failedAt.load(std::memory_order_relaxed); n++)
+            {
+                s[k.counter].i = counterAt(n);
+                k.run(k.body, s.data(), arrays);
+                if (n == count - 1)
+                    lastSlots = s;
+            }
+        }
+        catch (const KernelError& error)
+        {
+            std::lock_guard<std::mutex> lock(failureLock);
+            if (n < failedAt.load())
+            {
+                failedAt = n;
+                failure  = error;
+            }
+        }
+    });
+
+    // Bucla obisnuita se opreste la iteratia failedAt, dupa efectele celor dinaintea ei si
+    // cu ce a apucat sa faca failedAt. Firele au putut rula si iteratii de dupa ea, deci
+    // refacem 0 .. failedAt intr-un singur fir, de la valorile de dinainte de bucla: corpul
+    // nu are apeluri si nu afiseaza nimic, asa ca starea (si eroarea) ies exact ca in for.
+    bool failed = failure.message != nullptr;
+    if (failed && used > 1)
+    {
+        used = 1;
+        slots.assign(1, initial);
+        loadArrays(arrays);
+        std::vector<KValue>& s = slots[0];
+        try
+        {
+            for (long long n = 0; n <= failedAt; n++)
+            {
+                s[k.counter].i = counterAt(n);
+                k.run(k.body, s.data(), arrays);
+            }
+        }
+        catch (const KernelError&)
+        {
+        }
+    }
+
+    counter.value = itoaCustom(failed ? counterAt(failedAt) : static_cast<int>(last));
+    if (count > 0)
+    {
+        const std::vector<KValue>& ended = failed ? slots[0] : lastSlots;
+        for (int slot : k.locals)
+            k.slotVars[slot]->value = encodeValue(ended[slot], k.slotVars[slot]->type.base);
+        for (std::size_t r = 0; r < k.reductions.size(); r++)
+        {
+            int      slot  = k.reductions[r];
+            Category type  = k.slotVars[slot]->type.base;
+            KValue   total = slots[0][slot];
+            for (int t = 1; t < used; t++)
+                total = reductionCombine(st->parallel.reductions[r].op, type, total, slots[t][slot]);
+            k.slotVars[slot]->value = encodeValue(total, type);
+        }
+        for (std::size_t a = 0; a < k.arrayVars.size(); a++)
+        {
+            if (!k.arrayWritten[a])
+                continue;
+            VarSymbol& v = *k.arrayVars[a];
+            std::vector<std::string_view> elements = splitElements(v.value);
+            std::string text;
+            text.reserve(v.value.size());
+            for (std::size_t j = 0; j < elements.size(); j++)
+            {
+                if (j)
+                    text += ' ';
+                if (j < arrays.changed[a].size() && arrays.changed[a][j])
+                    text += encodeValue(arrays.values[a][j], v.type.base);
+                else
+                    text += elements[j];
+            }
+            v.value = std::move(text);
+        }
+    }
+
+    if (failed)
+    {
+        std::cerr << "[Line " << failure.line << "] Error: " << failure.message << "\n";
+        abortCompilation();
+    }
+
+    long long chunk = range.chunk > 0 ? range.chunk : (range.dynamic ? 1 : (count + used - 1) / used);
+    auto micros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - started);
+    std::cout << "[DEBUG] parallel for at line " << st->line << ": " << count << " iterations on " << used
+              << " threads (" << (range.dynamic ? "dynamic" : "static") << ", chunk " << chunk << ") in "
+              << micros.count() << " us\n";
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//               SESIUNEA INTERACTIVA (--repl)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Tabelele raman aceleasi pe toata sesiunea. Dupa fiecare element reusit retinem
+// cate intrari au; la o eroare, ce s-a adaugat de atunci (ex. variabilele locale ale
+// unei functii nereusite) se sterge, ca elementul sa poata fi scris din nou.
+struct ReplSnapshot
+{
+    int vars    = 0;
+    int funcs   = 0;
+    int classes = 0;
+};
+ReplSnapshot replSnapshot;
+
+// Starea de inceput a fiecarui element: domeniul global, ca in corpul lui main
+void replCommit()
+{
+    replSnapshot   = {varsNumber, funcNumber, classNumber};
+    domain         = SYM_GLOBAL;
+    functionDomain = SYM_GLOBAL;
+    inBody         = true;
+}
+
+void replRollback()
+{
+    for (int i = replSnapshot.vars; i < varsNumber; i++)
+        vars[i] = VarSymbol();
+    for (int i = replSnapshot.funcs; i < funcNumber; i++)
+        func[i] = FuncSymbol();
+    for (int i = replSnapshot.classes; i < classNumber; i++)
+        classes[i] = Clasa();
+    varsNumber  = replSnapshot.vars;
+    funcNumber  = replSnapshot.funcs;
+    classNumber = replSnapshot.classes;
+
+    paramTemp = "-";
+    paramVars.clear();
+    returning = false;
+    activeCalls.clear();
+    frameVars.clear();
+    funcVersion++;
+    replCommit();
+}
+
+void replExecute(Stmt* st)
+{
+    if (st)
+        execStmt(st);
+    returning = false;   // `return` in afara unei functii doar opreste instructiunea
+}
+
+void replShow(AST* expr, int yylineno)
+{
+    ResultAST value = evaluateTree(expr, yylineno);
+    std::cout << resultText(value) << " (" << convertEnumToString(value.treeType) << ")\n";
+}
+
+void freeStmt(Stmt* st);
+
+// Readuce compilatorul la starea de dinainte de parsare, ca sa putem compila mai
+// multe programe in acelasi proces (ex. harness-urile de fuzzing). Instructiunile
+// din main si din functii se elibereaza; ce ramasese dintr-un input respins nu.
+void resetCompiler()
+{
+    for (Stmt* st : mainBody)
+        freeStmt(st);
+    for (int i = 0; i < funcNumber; i++)
+        for (Stmt* st : func[i].body)
+            freeStmt(st);
+
+    symbols        = SymbolPool();
+    domain         = SYM_GLOBAL;
+    functionDomain = SYM_GLOBAL;
+    paramTemp      = "-";
+    inBody         = false;
+
+    for (int i = 0; i < classNumber; i++)
+        classes[i] = Clasa();
+    for (int i = 0; i < varsNumber; i++)
+        vars[i] = VarSymbol();
+    for (int i = 0; i < funcNumber; i++)
+        func[i] = FuncSymbol();
+    classNumber = varsNumber = funcNumber = 0;
+
+    paramVars.clear();
+    mainBody.clear();
+    lvalue      = LValue();
+    returning   = false;
+    returnValue = ResultAST();
+    activeCalls.clear();
+    frameVars.clear();
+    funcVersion++;
+    callStackLimit = 0;
+    channels.clear();
+    taskStates.clear();
+    scheduler.reset();
+    spawnUsed   = false;
+    parallelSpec = ParallelSpec();
+    kernels.clear();
+#ifdef LFAC_FUZZ
+    fuzzBudget = FUZZ_BUDGET;
+    RtString::heap.setNurserySize(GcHeap::MIN_NURSERY);   // colectari dese si pe input-uri mici
+#endif
+    replSnapshot = ReplSnapshot();
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          ELIMINAREA SIMBOLURILOR NEFOLOSITE (--prune)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Dupa parsare si inainte de executie pornim din main si urmarim apelurile si
+// accesele la variabile, atribute si obiecte. Functiile, clasele si variabilele
+// neatinse se scot din tabele; tabelele se compacteaza, iar pointerii / indecsii
+// din codul ramas se actualizeaza. Tot aici dispar instructiunile de dupa un
+// `return` si declaratiile locale nefolosite (daca initializarea nu apeleaza
+// functii). Corpurile eliminate se elibereaza; ce s-a scos apare in raport.
+
+struct PruneMarks
+{
+    std::vector<bool>        funcs, vars, classes;
+    std::vector<int>         pending;  // functii atinse, cu corpul inca neparcurs
+    std::vector<const Stmt*> decls;    // declaratiile locale din codul atins
+};
+
+// Dimensiunea codului (pentru raport)
+struct CodeSize
+{
+    int stmts = 0;
+    int nodes = 0;
+
+    std::size_t bytes() const
+    {
+        return stmts * sizeof(Stmt) + nodes * sizeof(AST);
+    }
+};
+
+int varIndex(const VarSymbol* v)
+{
+    return static_cast<int>(v - vars);
+}
+
+std::string qualifiedName(SymbolId dom, SymbolId name)
+{
+    if (dom == SYM_GLOBAL)
+        return symbols.name(name);
+    return symbols.name(dom) + "::" + symbols.name(name);
+}
+
+void markExpr(const AST* node, PruneMarks& marks)
+{
+    if (!node)
+        return;
+    if (node->var)
+        marks.vars[varIndex(node->var)] = true;
+    if (node->object)
+        marks.vars[varIndex(node->object)] = true;
+    if (node->category == Category::CALL && !marks.funcs[node->funcIndex])
+    {
+        marks.funcs[node->funcIndex] = true;
+        marks.pending.push_back(node->funcIndex);
+    }
+    markExpr(node->left, marks);
+    markExpr(node->right, marks);
+    markExpr(node->index, marks);
+    for (const AST* arg : node->args)
+        markExpr(arg, marks);
+}
+
+void markBlock(const std::vector<Stmt*>& block, PruneMarks& marks);
+
+void markStmt(const Stmt* st, PruneMarks& marks)
+{
+    if (!st)
+        return;
+    markExpr(st->expr, marks);
+    markExpr(st->target.index, marks);
+    if (st->kind == StmtKind::DECL)
+        marks.decls.push_back(st);      // declaratia singura nu e o folosire
+    else if (st->target.var)
+        marks.vars[varIndex(st->target.var)] = true;
+    if (st->target.object)
+        marks.vars[varIndex(st->target.object)] = true;
+    for (const Reduction& r : st->parallel.reductions)
+        marks.vars[varIndex(r.var)] = true;
+    markStmt(st->init, marks);
+    markStmt(st->step, marks);
+    markBlock(st->body, marks);
+    markBlock(st->elseBody, marks);
+}
+
+void markBlock(const std::vector<Stmt*>& block, PruneMarks& marks)
+{
+    for (const Stmt* st : block)
+        markStmt(st, marks);
+}
+
+// Graful apelurilor: pentru fiecare functie, functiile apelate direct din corpul ei
+std::vector<std::vector<int>> callGraph()
+{
+    std::vector<std::vector<int>> callees(funcNumber);
+    for (int i = 0; i < funcNumber; i++)
+    {
+        PruneMarks marks;
+        marks.funcs.assign(funcNumber, false);
+        marks.vars.assign(varsNumber, false);
+        markBlock(func[i].body, marks);
+        callees[i] = std::move(marks.pending);
+    }
+    return callees;
+}
+
+// Functiile la care se ajunge pornind de la apelurile din pending (inclusiv acestea)
+std::vector<bool> reachableFunctions(const std::vector<std::vector<int>>& callees, std::vector<int> pending)
+{
+    std::vector<bool> reached(callees.size(), false);
+    while (!pending.empty())
+    {
+        int f = pending.back();
+        pending.pop_back();
+        if (reached[f])
+            continue;
+        reached[f] = true;
+        for (int g : callees[f])
+            if (!reached[g])
+                pending.push_back(g);
+    }
+    return reached;
+}
+
+// Apelurile din bucla (antet si corp) ajung, direct sau nu, la o functie cu numele dom,
+// deci pot scrie variabilele ei locale (pt. loopRange)
+bool loopCallsReach(const Stmt* loop, SymbolId dom)
+{
+    PruneMarks marks;
+    marks.funcs.assign(funcNumber, false);
+    marks.vars.assign(varsNumber, false);
+    markStmt(loop, marks);
+    std::vector<bool> reached = reachableFunctions(callGraph(), marks.pending);
+    for (int f = 0; f < funcNumber; f++)
+        if (reached[f] && func[f].name == dom)
+            return true;
+    return false;
+}
+
+void measureTree(const AST* node, CodeSize& size)
+{
+    if (!node)
+        return;
+    size.nodes++;
+    measureTree(node->left, size);
+    measureTree(node->right, size);
+    measureTree(node->index, size);
+    for (const AST* arg : node->args)
+        measureTree(arg, size);
+}
+
+void measureStmt(const Stmt* st, CodeSize& size)
+{
+    if (!st)
+        return;
+    size.stmts++;
+    measureTree(st->expr, size);
+    measureTree(st->target.index, size);
+    measureStmt(st->init, size);
+    measureStmt(st->step, size);
+    for (const Stmt* child : st->body)
+        measureStmt(child, size);
+    for (const Stmt* child : st->elseBody)
+        measureStmt(child, size);
+}
+
+void freeTree(AST* node)
+{
+    if (!node)
+        return;
+    freeTree(node->left);
+    freeTree(node->right);
+    freeTree(node->index);
+    for (AST* arg : node->args)
+        freeTree(arg);
+    delete node;
+}
+
+void freeStmt(Stmt* st)
+{
+    if (!st)
+        return;
+    if (st->kind == StmtKind::PARALLEL_FOR)
+        kernels.erase(st);   // adresa poate fi refolosita de o instructiune noua
+    freeTree(st->expr);
+    freeTree(st->target.index);
+    freeStmt(st->init);
+    freeStmt(st->step);
+    for (Stmt* child : st->body)
+        freeStmt(child);
+    for (Stmt* child : st->elseBody)
+        freeStmt(child);
+    delete st;
+}
+
+// Instructiunile de dupa un return din acelasi bloc nu se executa niciodata
+void dropAfterReturn(std::vector<Stmt*>& block, std::vector<Stmt*>& removed)
+{
+    for (std::size_t i = 0; i < block.size(); i++)
+    {
+        dropAfterReturn(block[i]->body, removed);
+        dropAfterReturn(block[i]->elseBody, removed);
+        if (block[i]->kind == StmtKind::RETURN && i + 1 < block.size())
+        {
+            removed.insert(removed.end(), block.begin() + i + 1, block.end());
+            block.resize(i + 1);
+        }
+    }
+}
+
+void dropUnusedDecls(std::vector<Stmt*>& block, const PruneMarks& marks, std::vector<Stmt*>& removed)
+{
+    std::vector<Stmt*> kept;
+    for (Stmt* st : block)
+    {
+        if (st->kind == StmtKind::DECL && !marks.vars[varIndex(st->target.var)])
+        {
+            removed.push_back(st);
+            continue;
+        }
+        dropUnusedDecls(st->body, marks, removed);
+        dropUnusedDecls(st->elseBody, marks, removed);
+        kept.push_back(st);
+    }
+    block = kept;
+}
+
+// Dupa compactare: pointerii / indecsii din codul pastrat trec pe noile pozitii
+void remapExpr(AST* node, const std::vector<int>& varMap, const std::vector<int>& funcMap)
+{
+    if (!node)
+        return;
+    if (node->var)
+        node->var = &vars[varMap[varIndex(node->var)]];
+    if (node->object)
+        node->object = &vars[varMap[varIndex(node->object)]];
+    if (node->category == Category::CALL)
+        node->funcIndex = funcMap[node->funcIndex];
+    remapExpr(node->left, varMap, funcMap);
+    remapExpr(node->right, varMap, funcMap);
+    remapExpr(node->index, varMap, funcMap);
+    for (AST* arg : node->args)
+        remapExpr(arg, varMap, funcMap);
+}
+
+void remapStmt(Stmt* st, const std::vector<int>& varMap, const std::vector<int>& funcMap)
+{
+    if (!st)
+        return;
+    remapExpr(st->expr, varMap, funcMap);
+    remapExpr(st->target.index, varMap, funcMap);
+    if (st->target.var)
+        st->target.var = &vars[varMap[varIndex(st->target.var)]];
+    if (st->target.object)
+        st->target.object = &vars[varMap[varIndex(st->target.object)]];
+    for (Reduction& r : st->parallel.reductions)
+        r.var = &vars[varMap[varIndex(r.var)]];
+    remapStmt(st->init, varMap, funcMap);
+    remapStmt(st->step, varMap, funcMap);
+    for (Stmt* child : st->body)
+        remapStmt(child, varMap, funcMap);
+    for (Stmt* child : st->elseBody)
+        remapStmt(child, varMap, funcMap);
+}
+
+void pruneUnused(std::ostream& report)
+{
+    // 1. cod mort dupa return (inainte de marcare, ca apelurile de acolo sa nu conteze)
+    std::vector<Stmt*> deadStmts;
+    dropAfterReturn(mainBody, deadStmts);
+    for (int i = 0; i < funcNumber; i++)
+        dropAfterReturn(func[i].body, deadStmts);
+
+    // 2. tot ce se poate atinge din main
+    PruneMarks marks;
+    marks.funcs.assign(funcNumber, false);
+    marks.vars.assign(varsNumber, false);
+    marks.classes.assign(classNumber, false);
+    markBlock(mainBody, marks);
+    while (!marks.pending.empty())
+    {
+        int f = marks.pending.back();
+        marks.pending.pop_back();
+        for (VarSymbol* param : func[f].params)
+            marks.vars[varIndex(param)] = true;
+        markBlock(func[f].body, marks);
+    }
+
+    // o declaratie nefolosita ramane daca initializarea are efecte (apeluri)
+    for (const Stmt* decl : marks.decls)
+        if (containsCall(decl->expr))
+            marks.vars[varIndex(decl->target.var)] = true;
+
+    // clasele: tipul obiectelor, plus domeniul atributelor si al metodelor folosite
+    for (int i = 0; i < varsNumber; i++)
+    {
+        if (!marks.vars[i])
+            continue;
+        int c = classIndex(vars[i].type.name);
+        if (c >= 0) marks.classes[c] = true;
+        c = classIndex(vars[i].domain);
+        if (c >= 0) marks.classes[c] = true;
+    }
+    for (int i = 0; i < funcNumber; i++)
+    {
+        int c = marks.funcs[i] ? classIndex(func[i].domain) : -1;
+        if (c >= 0) marks.classes[c] = true;
+    }
+
+    dropUnusedDecls(mainBody, marks, deadStmts);
+    for (int i = 0; i < funcNumber; i++)
+        if (marks.funcs[i])
+            dropUnusedDecls(func[i].body, marks, deadStmts);
+
+    // 3. raportul
+    std::ostringstream details;
+    std::size_t totalBytes = 0;
+    int prunedFuncs = 0, prunedVars = 0, prunedClasses = 0;
+
+    details << "Functions:\n";
+    for (int i = 0; i < funcNumber; i++)
+    {
+        if (marks.funcs[i])
+            continue;
+        CodeSize size;
+        for (const Stmt* st : func[i].body)
+            measureStmt(st, size);
+        std::size_t bytes = sizeof(FuncSymbol) + size.bytes();
+        details << "  " << qualifiedName(func[i].domain, func[i].name) << ": " << size.stmts
+                << " statements, " << size.nodes << " nodes, " << bytes << " bytes\n";
+        totalBytes += bytes;
+        prunedFuncs++;
+    }
+    details << "Classes:\n";
+    for (int i = 0; i < classNumber; i++)
+    {
+        if (marks.classes[i])
+            continue;
+        int members = 0;
+        for (int v = 0; v < varsNumber; v++)
+            members += (vars[v].domain == classes[i].name);
+        for (int f = 0; f < funcNumber; f++)
+            members += (func[f].domain == classes[i].name);
+        details << "  " << symbols.name(classes[i].name) << ": " << members << " members\n";
+        totalBytes += sizeof(Clasa);
+        prunedClasses++;
+    }
+    details << "Variables:\n";
+    for (int i = 0; i < varsNumber; i++)
+    {
+        if (marks.vars[i])
+            continue;
+        std::size_t bytes = sizeof(VarSymbol) + vars[i].value.capacity() + vars[i].text.size();
+        details << "  " << qualifiedName(vars[i].domain, vars[i].name) << ": "
+                << typeToString(vars[i].type) << ", " << bytes << " bytes\n";
+        totalBytes += bytes;
+        prunedVars++;
+    }
+    std::sort(deadStmts.begin(), deadStmts.end(), [](const Stmt* a, const Stmt* b)
+              { return a->line < b->line; });
+    CodeSize dead;
+    for (const Stmt* st : deadStmts)
+        measureStmt(st, dead);
+    details << "Dead statements: " << deadStmts.size() << " (" << dead.bytes() << " bytes)\n";
+    for (const Stmt* st : deadStmts)
+        details << "  line " << st->line << "\n";
+    totalBytes += dead.bytes();
+
+    report << "Pruned " << prunedFuncs << " functions, " << prunedClasses << " classes, "
+           << prunedVars << " variables and " << deadStmts.size() << " statements ("
+           << totalBytes << " bytes)\n\n" << details.str();
+
+    // 4. eliberarea codului eliminat
+    for (Stmt* st : deadStmts)
+        freeStmt(st);
+    for (int i = 0; i < funcNumber; i++)
+    {
+        if (marks.funcs[i])
+            continue;
+        for (Stmt* st : func[i].body)
+            freeStmt(st);
+        func[i].body.clear();
+    }
+
+    // 5. compactarea tabelelor; intai pointerii din codul pastrat, apoi mutarea
+    std::vector<int> varMap(varsNumber, -1), funcMap(funcNumber, -1);
+    int keptVars = 0, keptFuncs = 0, keptClasses = 0;
+    for (int i = 0; i < varsNumber; i++)
+        if (marks.vars[i])
+            varMap[i] = keptVars++;
+    for (int i = 0; i < funcNumber; i++)
+        if (marks.funcs[i])
+            funcMap[i] = keptFuncs++;
+
+    for (Stmt* st : mainBody)
+        remapStmt(st, varMap, funcMap);
+    for (int i = 0; i < funcNumber; i++)
+    {
+        if (!marks.funcs[i])
+            continue;
+        for (Stmt* st : func[i].body)
+            remapStmt(st, varMap, funcMap);
+        for (VarSymbol*& param : func[i].params)
+            param = &vars[varMap[varIndex(param)]];
+    }
+
+    for (int i = 0; i < varsNumber; i++)
+        if (marks.vars[i] && varMap[i] != i)
+            vars[varMap[i]] = std::move(vars[i]);
+    for (int i = 0; i < funcNumber; i++)
+        if (marks.funcs[i] && funcMap[i] != i)
+            func[funcMap[i]] = std::move(func[i]);
+    for (int i = 0; i < classNumber; i++)
+        if (marks.classes[i])
+            classes[keptClasses++] = classes[i];
+
+    for (int i = keptVars; i < varsNumber; i++)
+        vars[i] = VarSymbol();
+    for (int i = keptFuncs; i < funcNumber; i++)
+        func[i] = FuncSymbol();
+    varsNumber  = keptVars;
+    funcNumber  = keptFuncs;
+    classNumber = keptClasses;
+    funcVersion++;
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          OPTIMIZARI: INLINING SI SPECIALIZARE (-O1 / -O2)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// Ruleaza dupa parsare, pe corpurile functiilor (in ordinea definirii, deci cele
+// apelate sunt deja optimizate) si apoi pe main:
+//  - expresiile cu operanzi constanti se calculeaza o data (foldLiterals, cu
+//    aceleasi operatii ca evaluateTree, dar fara [DEBUG] si fara erori: o operatie
+//    care ar esua ramane pentru rulare), la fel if-urile cu conditie constanta;
+//  - un apel f(a, b) al unei functii de forma `return E;` devine E, cu
+//    parametrii inlocuiti de argumente (-O1: E mic, -O2: pana la INLINE_O2);
+//  - un apel care e toata expresia unei instructiuni (x = f(a); Print(f(a)); ...)
+//    devine: parametrii = argumentele, corpul lui f, apoi instructiunea cu
+//    expresia din `return` (daca singurul return e ultima instructiune);
+//  - -O2: un apel cu argumente literale primeste o copie a functiei in care
+//    parametrii respectivi sunt constante (specializare), optimizata din nou; cel
+//    mult MAX_SPECIALIZATIONS copii per functie si doar cat mai e loc in func[]
+//    (altfel apelul ramane neschimbat: optimizarea nu are voie sa respinga programul).
+// Parametrii si variabilele locale sunt comune tuturor apelurilor unei functii, iar
+// corpul copiat foloseste aceleasi VarSymbol ca originalul. O functie recursiva
+// (direct sau prin altele) nu se copiaza: copia ar scrie peste valorile unui apel
+// in curs, fara salvarea pe care o face invokeFunction.
+
+constexpr int INLINE_O1 = 12;   // instructiuni + noduri din corpul functiei
+constexpr int INLINE_O2 = 48;
+constexpr int MAX_SPECIALIZATIONS = 8;   // copii specializate per functie
+
+struct OptStats
+{
+    int folded      = 0;
+    int inlined     = 0;
+    int specialized = 0;
+};
+
+struct Optimizer
+{
+    int      level       = 0;
+    int      inlineLimit = 0;
+    OptStats stats;
+    std::unordered_map<std::string, int> specializations; // "f#0=3;" -> indexul copiei
+    std::unordered_map<int, int>         copies;          // functia -> cate copii specializate are
+    std::vector<bool> recursive;                           // dupa indexul functiei (fara copii)
+};
+
+// Corpul lui func[fi] se poate copia in locul apelului (inlining / specializare)
+bool canCopy(int fi, const Optimizer& opt)
+{
+    return fi >= static_cast<int>(opt.recursive.size()) || !opt.recursive[fi];
+}
+
+using Substitution = std::vector<std::pair<const VarSymbol*, const AST*>>;
+
+bool isLiteral(const AST* node)
+{
+    if (!node || node->left || node->right)
+        return false;
+    switch (node->category)
+    {
+        case Category::NUMBER_INT:
+        case Category::NUMBER_FLOAT:
+        case Category::NUMBER_BOOL:
+        case Category::CHAR:
+        case Category::STRING:
+            return true;
+        default:
+            return false;
+    }
+}
+
+ResultAST literalValue(const AST* node)
+{
+    ResultAST value;
+    value.treeType  = node->treeType;
+    value.resultStr = node->label;
+    value.text      = node->text;
+    return value;
+}
+
+AST* makeLiteral(const ResultAST& value)
+{
+    AST* node = new AST();
+    node->category = value.treeType;
+    node->treeType = value.treeType;
+    node->label    = resultText(value);
+    node->text     = value.text;
+    return node;
+}
+
+AST* cloneTree(const AST* node, const Substitution& subst)
+{
+    if (!node)
+        return nullptr;
+    if (node->category == Category::IDENTIFIER && node->var && !node->index)
+    {
+        for (const auto& s : subst)
+            if (s.first == node->var)
+                return cloneTree(s.second, {});
+    }
+    AST* copy  = new AST(*node);
+    copy->left  = cloneTree(node->left, subst);
+    copy->right = cloneTree(node->right, subst);
+    copy->index = cloneTree(node->index, subst);
+    for (AST*& arg : copy->args)
+        arg = cloneTree(arg, subst);
+    return copy;
+}
+
+Stmt* cloneStmt(const Stmt* st, const Substitution& subst)
+{
+    if (!st)
+        return nullptr;
+    Stmt* copy = new Stmt(*st);
+    copy->expr         = cloneTree(st->expr, subst);
+    copy->target.index = cloneTree(st->target.index, subst);
+    copy->init         = cloneStmt(st->init, subst);
+    copy->step         = cloneStmt(st->step, subst);
+    for (Stmt*& child : copy->body)
+        child = cloneStmt(child, subst);
+    for (Stmt*& child : copy->elseBody)
+        child = cloneStmt(child, subst);
+    return copy;
+}
+
+int countUses(const AST* node, const VarSymbol* v)
+{
+    if (!node)
+        return 0;
+    int uses = (node->category == Category::IDENTIFIER && node->var == v) ? 1 : 0;
+    uses += countUses(node->left, v) + countUses(node->right, v) + countUses(node->index, v);
+    for (const AST* arg : node->args)
+        uses += countUses(arg, v);
+    return uses;
+}
+
+bool mentionsAny(const AST* node, const std::vector<VarSymbol*>& vs)
+{
+    for (const VarSymbol* v : vs)
+        if (countUses(node, v))
+            return true;
+    return false;
+}
+
+int bodySize(const std::vector<Stmt*>& body)
+{
+    CodeSize size;
+    for (const Stmt* st : body)
+        measureStmt(st, size);
+    return size.stmts + size.nodes;
+}
+
+int countReturns(const Stmt* st)
+{
+    if (!st)
+        return 0;
+    int n = (st->kind == StmtKind::RETURN) ? 1 : 0;
+    for (const Stmt* child : st->body)
+        n += countReturns(child);
+    for (const Stmt* child : st->elseBody)
+        n += countReturns(child);
+    return n;
+}
+
+// Valoarea unui operator cu operanzi literali, calculata fara evaluateTree: fara
+// liniile [DEBUG] si fara erori. Intoarce false daca operatia ar da o eroare la
+// rulare (ex. impartire la zero); atunci expresia ramane, iar eroarea apare doar
+// daca se ajunge acolo.
+bool foldLiterals(const AST* node, ResultAST& out)
+{
+    const std::string& op = node->label;
+    ResultAST left = literalValue(node->left);
+    out = ResultAST();
+    out.treeType = node->treeType;
+
+    if (node->category == Category::NUMBER_BOOL)
+    {
+        if (op == "!")
+            out.resultStr = isTrue(left) ? "false" : "true";
+        else if (op != "&&" && op != "||" && node->right)
+            out.resultStr = relationHolds(op, compareValues(left, literalValue(node->right))) ? "true" : "false";
+        else
+            return false;   // && si || se simplifica in foldConstant
+        return true;
+    }
+    if (!node->right)
+        return false;
+
+    ResultAST right = literalValue(node->right);
+    switch (node->treeType)
+    {
+        case Category::NUMBER_INT:
+        {
+            std::int32_t value;
+            if (!intArithmetic(op[0], std::stoi(left.resultStr), std::stoi(right.resultStr), value))
+                return false;
+            out.resultStr = itoaCustom(value);
+            return true;
+        }
+        case Category::NUMBER_FLOAT:
+        {
+            float value;
+            if (!floatArithmetic(op[0], std::stof(left.resultStr), std::stof(right.resultStr), value))
+                return false;
+            out.resultStr = ftoaCustom(value);
+            return true;
+        }
+        case Category::STRING:
+            if (op != "+")
+                return false;
+            out.text = left.text + right.text;
+            return true;
+        default:
+            return false;
+    }
+}
+
+// Operatorii cu operanzi literali se calculeaza acum; node e inlocuit cu rezultatul
+void foldConstant(AST*& node, Optimizer& opt)
+{
+    if (!node || !node->left || (node->category != Category::OPERATOR && node->category != Category::NUMBER_BOOL))
+        return;
+    const std::string& op = node->label;
+
+    // scurtcircuitare: false && x => false, true && x => x (x bool), la fel pt. ||
+    if ((op == "&&" || op == "||") && isLiteral(node->left))
+    {
+        bool left = isTrue(literalValue(node->left));
+        AST* folded = nullptr;
+        if (left == (op == "||"))
+        {
+            ResultAST value;
+            value.treeType  = Category::NUMBER_BOOL;
+            value.resultStr = left ? "true" : "false";
+            folded = makeLiteral(value);
+        }
+        else if (node->right->treeType == Category::NUMBER_BOOL)
+        {
+            folded = node->right;
+            node->right = nullptr;
+        }
+        if (folded)
+        {
+            freeTree(node);
+            node = folded;
+            opt.stats.folded++;
+        }
+        return;
+    }
+
+    if (!isLiteral(node->left) || (node->right && !isLiteral(node->right)))
+        return;
+    ResultAST value;
+    if (!foldLiterals(node, value))
+        return;
+
+    AST* folded = makeLiteral(value);
+    freeTree(node);
+    node = folded;
+    opt.stats.folded++;
+}
+
+void optimizeBlock(std::vector<Stmt*>& block, Optimizer& opt);
+void optimizeExpr(AST*& node, Optimizer& opt);
+
+// Apelul devine expresia din `return E;`, cu parametrii inlocuiti de argumente
+bool inlineExpr(AST*& call, Optimizer& opt)
+{
+    const FuncSymbol& f = func[call->funcIndex];
+    if (!canCopy(call->funcIndex, opt) || f.body.size() != 1 || f.body[0]->kind != StmtKind::RETURN ||
+        f.params.size() != call->args.size())
+        return false;
+    const AST* result = f.body[0]->expr;
+    if (containsCall(result) || result->treeType != call->treeType || bodySize(f.body) > opt.inlineLimit)
+        return false;
+
+    Substitution subst;
+    for (size_t i = 0; i < f.params.size(); i++)
+    {
+        const AST* arg = call->args[i];
+        if (containsCall(arg))
+            return false;
+        // un argument ne-trivial se evalueaza tot o singura data
+        bool trivial = isLiteral(arg) || (arg->category == Category::IDENTIFIER && !arg->index);
+        if (!trivial && countUses(result, f.params[i]) != 1)
+            return false;
+        subst.push_back({f.params[i], arg});
+    }
+
+    AST* inlined = cloneTree(result, subst);
+    freeTree(call);
+    call = inlined;
+    opt.stats.inlined++;
+    optimizeExpr(call, opt);   // argumentele constante pot permite noi calcule
+    return true;
+}
+
+// Copia lui f cu parametrii dati de argumentele literale (refolosita pt. aceleasi valori)
+bool specializeCall(AST* call, Optimizer& opt)
+{
+    int fi = call->funcIndex;
+    const FuncSymbol& f = func[fi];
+    if (!canCopy(fi, opt) || f.params.size() != call->args.size())
+        return false;
+
+    std::string key = std::to_string(fi) + "#";
+    std::string suffix;
+    Substitution subst;
+    std::vector<VarSymbol*> params;
+    std::vector<AST*> args;
+    for (size_t i = 0; i < f.params.size(); i++)
+    {
+        AST* arg = call->args[i];
+        bool dummy = false;
+        bool written = writesVar(f.body, f.params[i], dummy);
+        if (isLiteral(arg) && !written)
+        {
+            subst.push_back({f.params[i], arg});
+            key    += std::to_string(i) + "=" + arg->label + ";";
+            suffix += (suffix.empty() ? "" : ",") + arg->label;
+        }
+        else
+        {
+            params.push_back(f.params[i]);
+            args.push_back(arg);
+            suffix += (suffix.empty() ? "" : ",") + std::string("_");
+        }
+    }
+    if (subst.empty())
+        return false;
+
+    auto it = opt.specializations.find(key);
+    if (it == opt.specializations.end())
+    {
+        if (funcNumber >= LENMAX || opt.copies[fi] >= MAX_SPECIALIZATIONS)
+            return false;
+        opt.copies[fi]++;
+        FuncSymbol& spec = func[funcNumber];
+        spec.returnType = f.returnType;
+        spec.name       = symbols.intern(symbols.name(f.name) + "<" + suffix + ">");
+        spec.domain     = f.domain;
+        spec.params     = params;
+        spec.paramList  = "-";
+        for (size_t i = 0; i < params.size(); i++)
+            spec.paramList = (i ? spec.paramList + ", " : std::string()) + typeToString(params[i]->type);
+        for (const Stmt* st : f.body)
+            spec.body.push_back(cloneStmt(st, subst));
+        it = opt.specializations.emplace(key, funcNumber++).first;
+        funcVersion++;
+        optimizeBlock(spec.body, opt);
+        opt.stats.specialized++;
+    }
+
+    for (const auto& s : subst)
+        freeTree(const_cast<AST*>(s.second));
+    call->funcIndex = it->second;
+    call->label     = symbols.name(func[it->second].name);
+    call->args      = args;
+    return true;
+}
+
+void optimizeExpr(AST*& node, Optimizer& opt)
+{
+    if (!node)
+        return;
+    optimizeExpr(node->left, opt);
+    optimizeExpr(node->right, opt);
+    optimizeExpr(node->index, opt);
+    for (AST*& arg : node->args)
+        optimizeExpr(arg, opt);
+
+    if (node->category == Category::CALL)
+    {
+        if (inlineExpr(node, opt))
+            return;
+        if (opt.level >= 2 && specializeCall(node, opt))
+            inlineExpr(node, opt);
+        return;
+    }
+    foldConstant(node, opt);
+}
+
+// Instructiunea st (x = f(a), Print(f(a)), return f(a) ...) inlocuita cu corpul lui f
+bool inlineStmt(Stmt* st, std::vector<Stmt*>& out, Optimizer& opt)
+{
+    AST* call = st->expr;
+    bool usesValue = st->kind != StmtKind::EXPR;
+    if (!call || call->category != Category::CALL || st->target.index ||
+        (st->kind != StmtKind::ASSIGN && st->kind != StmtKind::DECL && st->kind != StmtKind::EXPR &&
+         st->kind != StmtKind::PRINT && st->kind != StmtKind::TYPEOF && st->kind != StmtKind::RETURN))
+        return false;
+
+    const FuncSymbol& f = func[call->funcIndex];
+    if (!canCopy(call->funcIndex, opt) || f.params.size() != call->args.size() || f.body.empty() ||
+        bodySize(f.body) > opt.inlineLimit)
+        return false;
+
+    // un singur return, ca ultima instructiune (sau niciunul, daca valoarea nu conteaza)
+    int returns = 0;
+    for (const Stmt* s : f.body)
+        returns += countReturns(s);
+    const Stmt* last = f.body.back();
+    bool endsWithReturn = last->kind == StmtKind::RETURN;
+    if (returns > (endsWithReturn ? 1 : 0) || (usesValue && !endsWithReturn))
+        return false;
+    if (usesValue && last->expr->treeType != call->treeType)
+        return false;
+
+    // argumentele se atribuie pe rand, deci nu au voie sa depinda de parametri / apeluri
+    for (const AST* arg : call->args)
+        if (containsCall(arg) || mentionsAny(arg, f.params))
+            return false;
+
+    for (size_t i = 0; i < f.params.size(); i++)
+    {
+        Stmt* assign = makeStmt(StmtKind::ASSIGN, cloneTree(call->args[i], {}), st->line);
+        assign->target.name = f.params[i]->name;
+        assign->target.var  = f.params[i];
+        out.push_back(assign);
+    }
+    size_t count = endsWithReturn ? f.body.size() - 1 : f.body.size();
+    for (size_t i = 0; i < count; i++)
+        out.push_back(cloneStmt(f.body[i], {}));
+
+    if (endsWithReturn && (usesValue || containsCall(last->expr)))
+    {
+        Stmt* tail = new Stmt(*st);
+        tail->expr = cloneTree(last->expr, {});
+        if (!usesValue)
+            tail->kind = StmtKind::EXPR;
+        out.push_back(tail);
+    }
+    freeTree(call);
+    delete st;
+    opt.stats.inlined++;
+    return true;
+}
+
+void optimizeStmt(Stmt* st, Optimizer& opt)
+{
+    if (st->kind == StmtKind::SPAWN)
+    {
+        // apelul ramane apel (porneste task-ul); doar argumentele se optimizeaza
+        for (AST*& arg : st->expr->args)
+            optimizeExpr(arg, opt);
+        return;
+    }
+    optimizeExpr(st->expr, opt);
+    optimizeExpr(st->target.index, opt);
+    if (st->init) optimizeStmt(st->init, opt);
+    if (st->step) optimizeStmt(st->step, opt);
+    optimizeBlock(st->body, opt);
+    optimizeBlock(st->elseBody, opt);
+}
+
+void optimizeBlock(std::vector<Stmt*>& block, Optimizer& opt)
+{
+    std::vector<Stmt*> out;
+    for (Stmt* st : block)
+    {
+        optimizeStmt(st, opt);
+
+        // if cu conditie constanta: ramane doar ramura aleasa
+        if (st->kind == StmtKind::IF && isLiteral(st->expr))
+        {
+            std::vector<Stmt*>& taken = isTrue(literalValue(st->expr)) ? st->body : st->elseBody;
+            out.insert(out.end(), taken.begin(), taken.end());
+            taken.clear();
+            freeStmt(st);
+            opt.stats.folded++;
+            continue;
+        }
+        if (inlineStmt(st, out, opt))
+            continue;
+        out.push_back(st);
+    }
+    block = out;
+}
+
+// Instructiuni + noduri AST care se pot executa pornind din main, si cate din noduri sunt apeluri
+struct CodeCount
+{
+    int instructions = 0;
+    int calls        = 0;
+};
+
+int countCalls(const AST* node)
+{
+    if (!node)
+        return 0;
+    int n = (node->category == Category::CALL) ? 1 : 0;
+    n += countCalls(node->left) + countCalls(node->right) + countCalls(node->index);
+    for (const AST* arg : node->args)
+        n += countCalls(arg);
+    return n;
+}
+
+int countCalls(const Stmt* st)
+{
+    if (!st)
+        return 0;
+    int n = countCalls(st->expr) + countCalls(st->target.index) + countCalls(st->init) + countCalls(st->step);
+    for (const Stmt* child : st->body)
+        n += countCalls(child);
+    for (const Stmt* child : st->elseBody)
+        n += countCalls(child);
+    return n;
+}
+
+CodeCount countInstructions()
+{
+    std::vector<bool> seen(funcNumber, false);
+    std::vector<const std::vector<Stmt*>*> pending{&mainBody};
+    CodeSize  size;
+    CodeCount count;
+    while (!pending.empty())
+    {
+        const std::vector<Stmt*>* body = pending.back();
+        pending.pop_back();
+        PruneMarks marks;
+        marks.funcs.assign(funcNumber, false);
+        marks.vars.assign(varsNumber, false);
+        markBlock(*body, marks);
+        for (const Stmt* st : *body)
+        {
+            measureStmt(st, size);
+            count.calls += countCalls(st);
+        }
+        for (int f : marks.pending)
+        {
+            if (!seen[f])
+            {
+                seen[f] = true;
+                pending.push_back(&func[f].body);
+            }
+        }
+    }
+    count.instructions = size.stmts + size.nodes;
+    return count;
+}
+
+void optimizeProgram(int level)
+{
+    Optimizer opt;
+    opt.level       = level;
+    opt.inlineLimit = (level >= 2) ? INLINE_O2 : INLINE_O1;
+
+    std::vector<std::vector<int>> callees = callGraph();
+    opt.recursive.assign(funcNumber, false);
+    for (int i = 0; i < funcNumber; i++)
+        opt.recursive[i] = reachableFunctions(callees, callees[i])[i];
+
+    CodeCount before = countInstructions();
+    int original = funcNumber;   // copiile specializate sunt optimizate cand se creeaza
+    for (int i = 0; i < original; i++)
+        optimizeBlock(func[i].body, opt);
+    optimizeBlock(mainBody, opt);
+    funcVersion++;   // corpurile au acum si codul functiilor copiate
+    CodeCount after = countInstructions();
+
+    std::cout << "Optimizer -O" << level << ": " << before.instructions << " -> " << after.instructions
+              << " instructions, " << before.calls << " -> " << after.calls
+              << " call sites reachable from main (" << opt.stats.inlined << " calls inlined, "
+              << opt.stats.specialized << " specializations, " << opt.stats.folded
+              << " constants folded)\n";
+}
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          MODULE: import "fisier"; SI INTERFETE PRECOMPILATE
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+
+// `import "numere.lfac";` e prins de lexer (intre doua declaratii globale). Un
+// modul contine clase, variabile / constante globale si functii, fara main, si
+// se importa o singura data per program. Calea e relativa la fisierul care importa.
+//  - Prima data lexer-ul citeste sursa modulului ca pe un buffer in plus, deci
+//    modulul trece prin parser ca si cum ar fi scris in locul lui import. La
+//    sfarsitul bufferului, tot ce a declarat modulul (clase, variabile, semnaturi
+//    si corpurile functiilor, deja verificate) se scrie in interfata "fisier.lfi".
+//  - Data urmatoare, daca hash-ul continutului sursei (si al modulelor importate
+//    de el) e cel din interfata, tabelele se completeaza direct din "fisier.lfi",
+//    fara lexer, parser si verificari de tipuri. Altfel modulul se parseaza din nou.
+// Un modul poate folosi doar ce declara el si modulele importate de el, ca
+// interfata lui sa fie valabila in orice program.
+
+constexpr std::uint32_t INTERFACE_VERSION = 2;
+const std::string       INTERFACE_MAGIC   = "LFI";
+
+struct ModuleInfo
+{
+    std::string      path;           // calea normalizata a sursei
+    std::uint64_t    hash = 0;       // hash-ul continutului sursei
+    std::vector<int> deps;           // modulele importate direct
+    bool             done = false;   // false cat timp se parseaza din sursa
+};
+
+std::vector<ModuleInfo> modules;
+std::vector<int>        moduleStack;           // modulele parsate acum din sursa
+std::string             sourceFile;            // fisierul principal (pt. caile relative)
+std::string             moduleSource;          // sursa data lexer-ului
+bool                    importsEnabled = false; // doar la compilarea unui fisier
+
+// FNV-1a pe 64 de biti, amestecat cu versiunea formatului
+std::uint64_t contentHash(const std::string& text)
+{
+    std::uint64_t h = 14695981039346656037ull ^ INTERFACE_VERSION;
+    for (unsigned char c : text)
+    {
+        h ^= c;
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+bool readFile(const std::string& path, std::string& text)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in)
+        return false;
+    std::ostringstream ss;
+    ss << in.rdbuf();
+    text = ss.str();
+    return true;
+}
+
+int findModule(const std::string& path)
+{
+    for (std::size_t i = 0; i < modules.size(); i++)
+        if (modules[i].path == path)
+            return static_cast<int>(i);
+    return -1;
+}
+
+std::string directoryOf(const std::string& path)
+{
+    return std::filesystem::path(path).parent_path().string();
+}
+
+std::string resolvePath(const std::string& dir, const std::string& name)
+{
+    std::filesystem::path p(name);
+    if (p.is_relative())
+        p = std::filesystem::path(dir) / p;
+    return p.lexically_normal().string();
+}
+
+// ~~~ Scrierea interfetei ~~~
+
+struct InterfaceWriter
+{
+    std::string       out;
+    int               module = -1;
+    std::vector<int>  varLocal, funcLocal; // index in tabel -> index in interfata (-1 = alt modul)
+    std::vector<bool> visible;             // modulele pe care le poate folosi (el + importurile)
+
+    void u8(unsigned v)
+    {
+        out.push_back(static_cast<char>(v));
+    }
+
+    void u32(std::uint32_t v)
+    {
+        for (int i = 0; i < 4; i++)
+            out.push_back(static_cast<char>(v >> (8 * i)));
+    }
+
+    void u64(std::uint64_t v)
+    {
+        u32(static_cast<std::uint32_t>(v));
+        u32(static_cast<std::uint32_t>(v >> 32));
+    }
+
+    void str(const std::string& s)
+    {
+        u32(static_cast<std::uint32_t>(s.size()));
+        out += s;
+    }
+
+    void sym(SymbolId id)
+    {
+        str(symbols.name(id));
+    }
+
+    void type(const TypeInfo& t)
+    {
+        u8(static_cast<unsigned>(t.base));
+        sym(t.name);
+        u32(static_cast<std::uint32_t>(t.dim));
+    }
+
+    // Ceva declarat in afara modulului si a importurilor lui: interfata n-ar fi valabila
+    void checkVisible(int owner, SymbolId dom, SymbolId name)
+    {
+        if (owner >= 0 && visible[owner])
+            return;
+        std::cerr << "Error: Module " << modules[module].path << " uses " << qualifiedName(dom, name)
+                  << ", which is declared outside the module and its imports.\n";
+        abortCompilation();
+    }
+
+    void varRef(const VarSymbol* v)
+    {
+        if (!v)
+        {
+            u8(0);
+            return;
+        }
+        int local = varLocal[varIndex(v)];
+        if (local >= 0)
+        {
+            u8(1);
+            u32(static_cast<std::uint32_t>(local));
+            return;
+        }
+        checkVisible(v->module, v->domain, v->name);
+        u8(2);
+        sym(v->domain);
+        sym(v->name);
+    }
+
+    void funcRef(int f)
+    {
+        if (funcLocal[f] >= 0)
+        {
+            u8(1);
+            u32(static_cast<std::uint32_t>(funcLocal[f]));
+            return;
+        }
+        checkVisible(func[f].module, func[f].domain, func[f].name);
+        u8(2);
+        sym(func[f].domain);
+        sym(func[f].name);
+    }
+
+    void classType(const TypeInfo& t)
+    {
+        if (t.base != Category::OTHER)
+            return;
+        for (int i = 0; i < classNumber; i++)
+            if (classes[i].name == t.name && classes[i].module != module)
+                checkVisible(classes[i].module, SYM_GLOBAL, t.name);
+    }
+
+    void tree(const AST* node)
+    {
+        if (!node)
+        {
+            u8(0);
+            return;
+        }
+        if (node->category == Category::CHANNEL)
+        {
+            std::cerr << "Error: Module " << modules[module].path << " uses channel operation " << node->label
+                      << "; channels belong to the main file.\n";
+            abortCompilation();
+        }
+        u8(1);
+        str(node->label);
+        u8(static_cast<unsigned>(node->category));
+        u8(static_cast<unsigned>(node->treeType));
+        str(node->text.str());
+        sym(node->sym);
+        varRef(node->var);
+        tree(node->index);
+        u8(node->indexSafe);
+        varRef(node->object);
+        if (node->category == Category::CALL)
+            funcRef(node->funcIndex);
+        u32(static_cast<std::uint32_t>(node->args.size()));
+        for (const AST* arg : node->args)
+            tree(arg);
+        tree(node->left);
+        tree(node->right);
+    }
+
+    void block(const std::vector<Stmt*>& body)
+    {
+        u32(static_cast<std::uint32_t>(body.size()));
+        for (const Stmt* st : body)
+            stmt(st);
+    }
+
+    void stmt(const Stmt* st)
+    {
+        if (!st)
+        {
+            u8(0);
+            return;
+        }
+        u8(1);
+        u8(static_cast<unsigned>(st->kind));
+        u32(static_cast<std::uint32_t>(st->line));
+        tree(st->expr);
+        sym(st->target.name);
+        varRef(st->target.var);
+        tree(st->target.index);
+        u8(st->target.indexSafe);
+        varRef(st->target.object);
+        stmt(st->init);
+        stmt(st->step);
+        block(st->body);
+        block(st->elseBody);
+        if (st->kind == StmtKind::PARALLEL_FOR)
+        {
+            u8(st->parallel.dynamic);
+            u32(static_cast<std::uint32_t>(st->parallel.chunk));
+            u32(static_cast<std::uint32_t>(st->parallel.reductions.size()));
+            for (const Reduction& r : st->parallel.reductions)
+            {
+                u8(static_cast<unsigned char>(r.op));
+                varRef(r.var);
+            }
+        }
+    }
+};
+
+void markVisible(int m, std::vector<bool>& visible)
+{
+    if (visible[m])
+        return;
+    visible[m] = true;
+    for (int dep : modules[m].deps)
+        markVisible(dep, visible);
+}
+
+// Tot ce a declarat modulul id, in "sursa.lfi" (scris intr-un fisier temporar, apoi redenumit)
+void writeInterface(int id)
+{
+    const ModuleInfo& m = modules[id];
+    InterfaceWriter w;
+    w.module = id;
+    w.visible.assign(modules.size(), false);
+    markVisible(id, w.visible);
+    w.varLocal.assign(varsNumber, -1);
+    w.funcLocal.assign(funcNumber, -1);
+
+    std::vector<int> ownClasses, ownVars, ownFuncs;
+    for (int i = 0; i < classNumber; i++)
+        if (classes[i].module == id)
+            ownClasses.push_back(i);
+    for (int i = 0; i < varsNumber; i++)
+    {
+        if (vars[i].module == id)
+        {
+            w.varLocal[i] = static_cast<int>(ownVars.size());
+            ownVars.push_back(i);
+        }
+    }
+    for (int i = 0; i < funcNumber; i++)
+    {
+        if (func[i].module == id)
+        {
+            w.funcLocal[i] = static_cast<int>(ownFuncs.size());
+            ownFuncs.push_back(i);
+        }
+    }
+
+    w.out += INTERFACE_MAGIC;
+    w.u32(INTERFACE_VERSION);
+    w.u64(m.hash);
+    w.u32(static_cast<std::uint32_t>(m.deps.size()));
+    for (int dep : m.deps)
+    {
+        w.str(std::filesystem::path(modules[dep].path).lexically_relative(directoryOf(m.path)).string());
+        w.u64(modules[dep].hash);
+    }
+
+    w.u32(static_cast<std::uint32_t>(ownClasses.size()));
+    for (int c : ownClasses)
+        w.sym(classes[c].name);
+
+    w.u32(static_cast<std::uint32_t>(ownVars.size()));
+    for (int i : ownVars)
+    {
+        const VarSymbol& v = vars[i];
+        w.classType(v.type);
+        w.type(v.type);
+        w.sym(v.name);
+        w.sym(v.domain);
+        w.u8(v.isConst);
+        w.str(v.value);
+        w.str(v.text.str());
+    }
+
+    w.u32(static_cast<std::uint32_t>(ownFuncs.size()));
+    for (int i : ownFuncs)
+    {
+        const FuncSymbol& f = func[i];
+        w.type(f.returnType);
+        w.sym(f.name);
+        w.str(f.paramList);
+        w.sym(f.domain);
+        w.u32(static_cast<std::uint32_t>(f.params.size()));
+        for (const VarSymbol* p : f.params)
+            w.varRef(p);
+        w.block(f.body);
+    }
+
+    std::string file = m.path + ".lfi";
+    std::string temp = file + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        out.write(w.out.data(), static_cast<std::streamsize>(w.out.size()));
+        if (!out)
+        {
+            std::cout << "[DEBUG] Could not write module interface " << file << "\n";
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+    if (std::rename(temp.c_str(), file.c_str()) != 0)
+        std::remove(temp.c_str());
+    else
+        std::cout << "[DEBUG] Wrote module interface " << file << " (" << w.out.size() << " bytes)\n";
+}
+
+// ~~~ Citirea interfetei ~~~
+
+struct InterfaceReader
+{
+    const char* p;
+    const char* end;
+    bool        ok = true;
+    int         varBase = 0, varCount = 0;    // unde ajung variabilele / functiile in tabele
+    int         funcBase = 0, funcCount = 0;
+
+    bool need(std::size_t n)
+    {
+        if (ok && static_cast<std::size_t>(end - p) < n)
+            ok = false;
+        return ok;
+    }
+
+    unsigned u8()
+    {
+        return need(1) ? static_cast<unsigned char>(*p++) : 0;
+    }
+
+    std::uint32_t u32()
+    {
+        if (!need(4))
+            return 0;
+        std::uint32_t v = 0;
+        for (int i = 0; i < 4; i++)
+            v |= static_cast<std::uint32_t>(static_cast<unsigned char>(*p++)) << (8 * i);
+        return v;
+    }
+
+    std::uint64_t u64()
+    {
+        std::uint64_t lo = u32();
+        return lo | (static_cast<std::uint64_t>(u32()) << 32);
+    }
+
+    std::string str()
+    {
+        std::uint32_t n = u32();
+        if (!need(n))
+            return std::string();
+        std::string s(p, n);
+        p += n;
+        return s;
+    }
+
+    SymbolId sym()
+    {
+        return symbols.intern(str());
+    }
+
+    Category category()
+    {
+        unsigned c = u8();
+        if (c > static_cast<unsigned>(Category::OTHER))
+            ok = false;
+        return ok ? static_cast<Category>(c) : Category::OTHER;
+    }
+
+    TypeInfo type()
+    {
+        TypeInfo t;
+        t.base = category();
+        t.name = sym();
+        t.dim  = static_cast<int>(u32());
+        return t;
+    }
+
+    VarSymbol* varRef()
+    {
+        unsigned tag = u8();
+        if (tag == 1)
+        {
+            std::uint32_t local = u32();
+            if (local < static_cast<std::uint32_t>(varCount))
+                return &vars[varBase + local];
+        }
+        else if (tag == 2)
+        {
+            SymbolId dom  = sym();
+            SymbolId name = sym();
+            for (int i = 0; i < varBase; i++)
+                if (vars[i].name == name && vars[i].domain == dom)
+                    return &vars[i];
+        }
+        else if (tag == 0)
+        {
+            return nullptr;
+        }
+        ok = false;
+        return nullptr;
+    }
+
+    int funcRef()
+    {
+        unsigned tag = u8();
+        if (tag == 1)
+        {
+            std::uint32_t local = u32();
+            if (local < static_cast<std::uint32_t>(funcCount))
+                return funcBase + static_cast<int>(local);
+        }
+        else if (tag == 2)
+        {
+            SymbolId dom  = sym();
+            SymbolId name = sym();
+            for (int i = 0; i < funcBase; i++)
+                if (func[i].name == name && func[i].domain == dom)
+                    return i;
+        }
+        ok = false;
+        return 0;
+    }
+
+    AST* tree()
+    {
+        if (!ok || u8() == 0)
+            return nullptr;
+        AST* node = new AST();
+        node->label     = str();
+        node->category  = category();
+        node->treeType  = category();
+        node->text      = RtString(str());
+        node->sym       = sym();
+        node->var       = varRef();
+        node->index     = tree();
+        node->indexSafe = u8() != 0;
+        node->object    = varRef();
+        if (node->category == Category::CALL)
+            node->funcIndex = funcRef();
+        std::uint32_t args = u32();
+        for (std::uint32_t i = 0; i < args && ok; i++)
+            node->args.push_back(tree());
+        node->left  = tree();
+        node->right = tree();
+        return node;
+    }
+
+    void block(std::vector<Stmt*>& body)
+    {
+        std::uint32_t n = u32();
+        for (std::uint32_t i = 0; i < n && ok; i++)
+            body.push_back(stmt());
+    }
+
+    Stmt* stmt()
+    {
+        if (!ok || u8() == 0)
+            return nullptr;
+        Stmt* st = new Stmt();
+        unsigned kind = u8();
+        if (kind > static_cast<unsigned>(StmtKind::PARALLEL_FOR))
+            ok = false;
+        st->kind             = static_cast<StmtKind>(kind);
+        st->line             = static_cast<int>(u32());
+        st->expr             = tree();
+        if (st->kind == StmtKind::SPAWN)
+        {
+            if (!st->expr || st->expr->category != Category::CALL)
+                ok = false;
+            else
+                checkCooperativeTasks(st->line);
+            spawnUsed = true;
+        }
+        st->target.name      = sym();
+        st->target.var       = varRef();
+        st->target.index     = tree();
+        st->target.indexSafe = u8() != 0;
+        st->target.object    = varRef();
+        st->init             = stmt();
+        st->step             = stmt();
+        block(st->body);
+        block(st->elseBody);
+        if (st->kind == StmtKind::PARALLEL_FOR)
+        {
+            // forma buclei si corpul se verifica din nou cand se construieste kernel-ul
+            st->parallel.dynamic = u8() != 0;
+            st->parallel.chunk   = static_cast<int>(u32());
+            std::uint32_t count  = u32();
+            if (!st->init || !st->step || !st->expr || st->parallel.chunk < 0 || count > LENMAX)
+                ok = false;
+            for (std::uint32_t i = 0; i < count && ok; i++)
+            {
+                char       op = static_cast<char>(u8());
+                VarSymbol* v  = varRef();
+                if (!v || (op != '+' && op != '*' && op != '<' && op != '>'))
+                    ok = false;
+                st->parallel.reductions.push_back({op, v});
+            }
+        }
+        return st;
+    }
+};
+
+// Conflictele cu ce exista deja se raporteaza ca la declararea din sursa
+void checkImportedNames(const std::vector<SymbolId>& newClasses, const std::vector<VarSymbol>& newVars,
+                        const std::vector<FuncSymbol>& newFuncs, int yylineno)
+{
+    for (SymbolId c : newClasses)
+    {
+        for (int i = 0; i < classNumber; i++)
+        {
+            if (classes[i].name == c)
+            {
+                std::cerr << "[Line " << yylineno << "] Error: Class " << symbols.name(c)
+                          << " has already been defined\n";
+                abortCompilation();
+            }
+        }
+    }
+    for (const VarSymbol& v : newVars)
+    {
+        for (int i = 0; i < varsNumber; i++)
+        {
+            if (vars[i].name == v.name && vars[i].domain == v.domain)
+            {
+                std::cerr << "[Line " << yylineno << "] Error: Variable " << symbols.name(v.name)
+                          << " has already been declared\n";
+                abortCompilation();
+            }
+        }
+    }
+    for (const FuncSymbol& f : newFuncs)
+    {
+        for (int i = 0; i < funcNumber; i++)
+        {
+            if (func[i].name == f.name && func[i].domain == f.domain)
+            {
+                std::cerr << "[Line " << yylineno << "] Error: Function " << symbols.name(f.name)
+                          << " has already been declared\n";
+                abortCompilation();
+            }
+        }
+    }
+}
+
+// Incarca "path.lfi" daca se potriveste cu sursa (hash) si cu modulele importate de ea;
+// la succes modulul e inregistrat si tabelele completate, altfel nu se schimba nimic
+bool loadInterface(const std::string& path, std::uint64_t hash, int yylineno, int depth = 0)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::string data;
+    if (depth > 64 || !readFile(path + ".lfi", data))
+        return false;
+
+    InterfaceReader in{data.data(), data.data() + data.size()};
+    if (data.compare(0, INTERFACE_MAGIC.size(), INTERFACE_MAGIC) != 0)
+        return false;
+    in.p += INTERFACE_MAGIC.size();
+    if (in.u32() != INTERFACE_VERSION || in.u64() != hash || !in.ok)
+        return false;
+
+    // modulele importate: deja incarcate cu acelasi continut, sau cu interfata valida
+    std::vector<int> deps;
+    std::uint32_t depCount = in.u32();
+    for (std::uint32_t i = 0; i < depCount && in.ok; i++)
+    {
+        std::string   depPath = resolvePath(directoryOf(path), in.str());
+        std::uint64_t depHash = in.u64();
+        int dep = findModule(depPath);
+        if (dep < 0)
+        {
+            std::string depSource;
+            if (!in.ok || !readFile(depPath, depSource) || contentHash(depSource) != depHash ||
+                !loadInterface(depPath, depHash, yylineno, depth + 1))
+                return false;
+            dep = findModule(depPath);
+        }
+        if (!modules[dep].done || modules[dep].hash != depHash)
+            return false;
+        deps.push_back(dep);
+    }
+
+    std::uint32_t classCount = in.u32();
+    if (!in.ok || classCount > static_cast<std::uint32_t>(LENMAX - classNumber))
+        return false;
+    std::vector<SymbolId> newClasses(classCount);
+    for (SymbolId& c : newClasses)
+        c = in.sym();
+
+    std::uint32_t varCount = in.u32();
+    if (!in.ok || varCount > static_cast<std::uint32_t>(LENMAX - varsNumber))
+        return false;
+    std::vector<VarSymbol> newVars(varCount);
+    in.varBase  = varsNumber;
+    in.varCount = static_cast<int>(varCount);
+    for (VarSymbol& v : newVars)
+    {
+        v.type    = in.type();
+        v.name    = in.sym();
+        v.domain  = in.sym();
+        v.isConst = in.u8() != 0;
+        v.value   = in.str();
+        v.text    = RtString(in.str());
+    }
+
+    std::uint32_t funcCount = in.u32();
+    if (!in.ok || funcCount > static_cast<std::uint32_t>(LENMAX - funcNumber))
+        return false;
+    std::vector<FuncSymbol> newFuncs(funcCount);
+    in.funcBase  = funcNumber;
+    in.funcCount = static_cast<int>(funcCount);
+    for (FuncSymbol& f : newFuncs)
+    {
+        f.returnType = in.type();
+        f.name       = in.sym();
+        f.paramList  = in.str();
+        f.domain     = in.sym();
+        std::uint32_t params = in.u32();
+        for (std::uint32_t i = 0; i < params && in.ok; i++)
+            f.params.push_back(in.varRef());
+        in.block(f.body);
+    }
+
+    if (!in.ok || in.p != in.end)
+    {
+        for (FuncSymbol& f : newFuncs)
+            for (Stmt* st : f.body)
+                freeStmt(st);
+        return false;
+    }
+
+    checkImportedNames(newClasses, newVars, newFuncs, yylineno);
+
+    int id = static_cast<int>(modules.size());
+    modules.push_back({path, hash, deps, true});
+    for (SymbolId c : newClasses)
+    {
+        classes[classNumber].name   = c;
+        classes[classNumber].module = id;
+        classNumber++;
+    }
+    for (VarSymbol& v : newVars)
+    {
+        v.module = id;
+        vars[varsNumber++] = v;
+    }
+    for (FuncSymbol& f : newFuncs)
+    {
+        f.module = id;
+        func[funcNumber++] = f;
+    }
+    funcVersion++;
+
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "[DEBUG] Loaded module interface " << path << ".lfi: " << newClasses.size() << " classes, "
+              << newVars.size() << " variables, " << newFuncs.size() << " functions in "
+              << us.count() << " us\n";
+    return true;
+}
+
+// Apelata din lexer pt. `import "name";`. Intoarce sursa modulului daca trebuie
+// parsata (lexer-ul o citeste in locul lui import), nullptr daca s-a incarcat
+// din interfata sau era deja importat.
+const std::string* beginImport(const char* text, int len, int yylineno)
+{
+    std::string name(text, len);
+    if (!importsEnabled)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: import is only available when compiling a file.\n";
+        abortCompilation();
+    }
+
+    std::string from = moduleStack.empty() ? sourceFile : modules[moduleStack.back()].path;
+    std::string path = resolvePath(directoryOf(from), name);
+    int parent = moduleStack.empty() ? -1 : moduleStack.back();
+
+    int id = findModule(path);
+    if (id >= 0 && !modules[id].done)
+    {
+        std::cerr << "[Line " << yylineno << "] Error: Circular import of module " << name << "\n";
+        abortCompilation();
+    }
+    if (id < 0)
+    {
+        std::string source;
+        if (!readFile(path, source))
+        {
+            std::cerr << "[Line " << yylineno << "] Error: Cannot open module " << name << "\n";
+            abortCompilation();
+        }
+        std::uint64_t hash = contentHash(source);
+        if (!loadInterface(path, hash, yylineno))
+        {
+            // din sursa: lexer-ul citeste textul, endImport scrie interfata
+            id = static_cast<int>(modules.size());
+            modules.push_back({path, hash, {}, false});
+            if (parent >= 0)
+                modules[parent].deps.push_back(id);
+            moduleStack.push_back(id);
+            currentModule = id;
+            importTrail.push_back(path + " (imported at line " + std::to_string(yylineno) + ")");
+            moduleSource = std::move(source);
+            std::cout << "[DEBUG] Compiling module " << path << "\n";
+            return &moduleSource;
+        }
+        id = findModule(path);
+    }
+
+    if (parent >= 0 && std::find(modules[parent].deps.begin(), modules[parent].deps.end(), id) ==
+                       modules[parent].deps.end())
+        modules[parent].deps.push_back(id);
+    return nullptr;
+}
+
+// Apelata din lexer la sfarsitul sursei unui modul
+void endImport()
+{
+    int id = moduleStack.back();
+    writeInterface(id);
+    modules[id].done = true;
+    moduleStack.pop_back();
+    importTrail.pop_back();
+    currentModule = moduleStack.empty() ? -1 : moduleStack.back();
 }
 
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
@@ -941,19 +5155,19 @@ void printAll()
 {
     for (int i = 0; i < varsNumber; i++)
     {
-        std::cout << (i+1) << ". Name: " << vars[i].name 
-                  << ", Type: " << vars[i].type
-                  << ", Value: " << vars[i].value
-                  << ", Domain: " << vars[i].domain
+        std::cout << (i+1) << ". Name: " << symbols.name(vars[i].name)
+                  << ", Type: " << typeToString(vars[i].type)
+                  << ", Value: " << varValueText(vars[i])
+                  << ", Domain: " << symbols.name(vars[i].domain)
                   << ", Constant: " << (vars[i].isConst ? "yes" : "no")
                   << "\n";
     }
     for (int i = 0; i < funcNumber; i++)
     {
-        std::cout << (i+1) << ". Name: " << func[i].name
-                  << ", Returned type: " << func[i].returnType
+        std::cout << (i+1) << ". Name: " << symbols.name(func[i].name)
+                  << ", Returned type: " << typeToString(func[i].returnType)
                   << ", Parameters: " << func[i].paramList
-                  << ", Domain: " << func[i].domain
+                  << ", Domain: " << symbols.name(func[i].domain)
                   << "\n";
     }
 }
@@ -963,10 +5177,10 @@ void printVar(std::ostream& os)
 {
     for (int i = 0; i < varsNumber; i++)
     {
-        os << (i+1) << ". Name: " << vars[i].name
-           << ", Type: " << vars[i].type
-           << ", Value: " << vars[i].value
-           << ", Domain: " << vars[i].domain
+        os << (i+1) << ". Name: " << symbols.name(vars[i].name)
+           << ", Type: " << typeToString(vars[i].type)
+           << ", Value: " << varValueText(vars[i])
+           << ", Domain: " << symbols.name(vars[i].domain)
            << ", Constant: " << (vars[i].isConst ? "yes" : "no")
            << "\n";
     }
@@ -976,10 +5190,10 @@ void printFunc(std::ostream& os)
 {
     for (int i = 0; i < funcNumber; i++)
     {
-        os << (i+1) << ". Name: " << func[i].name
-           << ", Returned type: " << func[i].returnType
+        os << (i+1) << ". Name: " << symbols.name(func[i].name)
+           << ", Returned type: " << typeToString(func[i].returnType)
            << ", Parameters: " << func[i].paramList
-           << ", Domain: " << func[i].domain
+           << ", Domain: " << symbols.name(func[i].domain)
            << "\n";
     }
 }
@@ -1,6 +1,7 @@
 %{
 #include <iostream>
 #include <fstream>
+#include <sstream>
 #include <string>
 #include "compiler.hpp"   // Aici avem structurile, enum class Category, functiile etc.
 
@@ -11,27 +12,45 @@ extern int yylex();
 void yyerror(const char * s);
 %}
 
+%define api.push-pull both   /* yyparse pt. fisiere, yypush_parse pt. REPL */
+
+%code requires {
+#include <vector>
+struct AST;
+struct Stmt;
+}
+
 %union {
     char* string;
     int int_val;
     float float_val;
+    unsigned int sym;   /* SymbolId din pool-ul de simboluri */
     struct AST* tree;
+    struct Stmt* stmt;
+    std::vector<struct AST*>* exprs;
+    std::vector<struct Stmt*>* stmts;
 }
 
 /* Listam TOATE token-urile */
 %token <string> RETURN CLASS CONST MAIN PRINT  TYPEOF
-%token <string> TYPE VOID ID ASSIGN VAR_CHAR VAR_STRING
+%token <sym> TYPE ID
+%token <string> VOID ASSIGN VAR_CHAR VAR_STRING
 %token <int_val> VAR_INT
 %token <float_val> VAR_FLOAT
 %token <string> VAR_BOOL
 %token <string> LESS GR LEQ GEQ 
 %token <string> EQ NEQ
 %token <string> NOT AND OR
-%token <string> IF ELSE FOR DO WHILE
+%token <string> ELSE
+%token <int_val> IF FOR DO WHILE SPAWN PARALLEL   /* linia cuvantului cheie, pt. instructiunea construita */
+%token CHAN
+%token REPL_START REPL_END         /* nu vin din lexer: le trimite driver-ul REPL */
 
 %type <tree> EXPR
 %type <tree> COND
-%type <string> LVALUE
+%type <stmt> VAR_DECL INSTR STATEMENT if while do for PARALLEL_HEAD
+%type <stmts> INSTR_LIST
+%type <exprs> ARGS_LIST
 
 %start progr
 
@@ -53,6 +72,37 @@ progr
     {
       std::cout << "Unexpected text after end of program!" << std::endl;
     }
+  | REPL_START REPL_SESSION
+  ;
+
+/* =============== REPL =============== */
+/* Sesiunea interactiva (./compiler --repl): fiecare element se executa imediat
+   ce e parsat. Driver-ul trimite REPL_END la sfarsitul unei linii cu parantezele
+   inchise, deci un element poate continua pe mai multe linii. */
+REPL_SESSION
+  : /* epsilon */
+  | REPL_SESSION REPL_ITEM
+  ;
+
+REPL_ITEM
+  : STATEMENT REPL_END
+    {
+      if ($1)
+        analyzeBounds({ $1 });
+      replExecute($1);
+      freeStmt($1);   // instructiunea nu mai ruleaza
+      replCommit();
+    }
+  | EXPR REPL_END
+    {
+      // expresie fara ';' => se afiseaza valoarea
+      replShow($1, yylineno);
+      freeTree($1);
+      replCommit();
+    }
+  | FUNC_DECL REPL_END         { replCommit(); }
+  | USER_DEFINED_TYPE REPL_END { replCommit(); }
+  | REPL_END
   ;
 
 SECTIONS 
@@ -69,15 +119,16 @@ SECT1_USER_DEFINED_DATA
 USER_DEFINED_TYPE 
   : CLASS ID 
     {
-      // domain si functionDomain sunt std::string
+      // domain si functionDomain sunt id-uri din pool
       domain = $2; 
+      inBody = false; // atributele se initializeaza la parsare (si in REPL)
       addClass($2, yylineno);
       functionDomain = $2;
     }
     '{' INSIDE_CLASS '}' ';'
     {
-      domain = "global";
-      functionDomain = "global";
+      domain = SYM_GLOBAL;
+      functionDomain = SYM_GLOBAL;
     }
   ;
 
@@ -89,6 +140,11 @@ INSIDE_CLASS
 
 SECT2_GLOBAL_VARIABLES 
   : VAR_DECL ';'
+  | CHAN TYPE ID '(' EXPR ')' ';'
+    {
+      // canal global cu capacitate fixa: chan int c(4);
+      addChannel($2, $3, evaluateTree($5, yylineno), yylineno);
+    }
   ;
 
 SECT3_GLOBAL_FUNCTIONS 
@@ -98,54 +154,79 @@ SECT3_GLOBAL_FUNCTIONS
 SECT4_MAIN 
   : TYPE MAIN 
     {
-      domain = "main";
+      domain = SYM_MAIN;
+      inBody = true;
     }
     '(' ')' '{' INSTR_LIST '}' 
+    {
+      mainBody = std::move(*$7);
+      delete $7;
+      analyzeBounds(mainBody);
+      inBody = false;
+    }
   ;
 
 
 /* =============== VAR_DECL =============== */
+/* In corpul functiilor / al lui main, initializarea devine o instructiune DECL
+   executata la rulare; global si in clase se evalueaza direct, la parsare. */
 VAR_DECL 
   : TYPE ID 
     {
       AST* aux = buildTree(
-          (std::string($1) == "bool") ? "false" : "0",
-          convertStringToEnum($1),
+          ($1 == SYM_BOOL) ? "false" : "0",
+          categoryOfSymbol($1),
           nullptr, nullptr, yylineno
       );
-      addVar($1, $2, evaluateTree(aux, yylineno), domain, false, yylineno);
+      addVar(typeFromSymbol($1), $2, evaluateTree(aux, yylineno), domain, false, yylineno);
+      freeTree(aux);
+      $$ = inBody ? makeDeclStmt(nullptr, yylineno) : nullptr;
     }
   | CONST TYPE ID 
     {
       AST* aux = buildTree(
-          (std::string($2) == "bool") ? "false":"0",
-          convertStringToEnum($2),
+          ($2 == SYM_BOOL) ? "false":"0",
+          categoryOfSymbol($2),
           nullptr, nullptr, yylineno
       );
-      addVar($2, $3, evaluateTree(aux, yylineno), domain, true, yylineno);
+      addVar(typeFromSymbol($2), $3, evaluateTree(aux, yylineno), domain, true, yylineno);
+      freeTree(aux);
+      $$ = inBody ? makeDeclStmt(nullptr, yylineno) : nullptr;
     }
   | TYPE ID ASSIGN EXPR 
     {
-      addVar($1, $2, evaluateTree($4, yylineno), domain, false, yylineno);
+      addVar(typeFromSymbol($1), $2, inBody ? defaultValue(typeFromSymbol($1)) : evaluateTree($4, yylineno),
+             domain, false, yylineno);
+      $$ = inBody ? makeDeclStmt($4, yylineno) : nullptr;
+      if (!inBody)
+        freeTree($4);
     }
   | CONST TYPE ID ASSIGN EXPR
     {
-      addVar($2, $3, evaluateTree($5, yylineno), domain, true, yylineno);
+      addVar(typeFromSymbol($2), $3, inBody ? defaultValue(typeFromSymbol($2)) : evaluateTree($5, yylineno),
+             domain, true, yylineno);
+      $$ = inBody ? makeDeclStmt($5, yylineno) : nullptr;
+      if (!inBody)
+        freeTree($5);
     }
   | TYPE ID '[' EXPR ']'
     {
       int size = checkSize(evaluateTree($4, yylineno), yylineno);
+      freeTree($4);
       addArray($1, $2, size, domain, false, yylineno);
+      $$ = inBody ? makeDeclStmt(nullptr, yylineno) : nullptr;
     }
   | ID ID 
     {
       checkClass($1, yylineno);
       AST* aux = buildTree("0", Category::OTHER, nullptr, nullptr, yylineno);
-      addVar($1, $2, evaluateTree(aux, yylineno), domain, false, yylineno);
+      addVar(typeFromSymbol($1), $2, evaluateTree(aux, yylineno), domain, false, yylineno);
+      freeTree(aux);
+      $$ = nullptr;
     }
-  | TYPE ID '[' EXPR ']' '[' EXPR ']' 
-  | TYPE ID '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' 
-  | TYPE ID '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' 
+  | TYPE ID '[' EXPR ']' '[' EXPR ']' { $$ = nullptr; }
+  | TYPE ID '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' { $$ = nullptr; }
+  | TYPE ID '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' '[' EXPR ']' { $$ = nullptr; }
   ;
 
 /* =============== FUNC_DECL =============== */
@@ -153,11 +234,18 @@ FUNC_DECL
   : TYPE ID 
     {
       domain = $2;
+      inBody = true;
+    }
+    '(' PARAM_LIST ')'
+    {
+      $<int_val>$ = addFunction($1, $2, functionDomain, yylineno);
     }
-    '(' PARAM_LIST ')' '{' INSTR_LIST '}' 
+    '{' INSTR_LIST '}' 
     {
-      addFunction($1, $2, functionDomain, yylineno);
-      domain = "global";
+      analyzeBounds(*$9);
+      setFunctionBody($<int_val>7, $9);
+      domain = SYM_GLOBAL;
+      inBody = false;
     }
   ;
 
@@ -170,25 +258,42 @@ PARAM_LIST
 /* =============== INSTR_LIST =============== */
 INSTR_LIST 
   : /* epsilon */
-  | INSTR_LIST VAR_DECL ';'
-  | INSTR_LIST INSTR ';'
-  | INSTR_LIST if
-  | INSTR_LIST while
-  | INSTR_LIST do
-  | INSTR_LIST for
-  | INSTR_LIST RETURN EXPR ';'
+    {
+      $$ = new std::vector<Stmt*>();
+    }
+  | INSTR_LIST STATEMENT
+    {
+      $$ = $1;
+      if ($2)
+        $$->push_back($2);
+    }
+  ;
+
+/* O instructiune din corp (sau din REPL); nullptr pt. declaratiile facute la parsare */
+STATEMENT
+  : VAR_DECL ';' { $$ = $1; }
+  | INSTR ';'    { $$ = $1; }
+  | if
+  | while
+  | do
+  | for
+  | RETURN EXPR ';'
     {
       // Ex: return expr;
-      // Aici doar parsam; interpretarea e la execuție
+      $$ = makeStmt(StmtKind::RETURN, $2, yylineno);
+    }
+  | PRINT '(' EXPR ')' ';'
+    {
+      $$ = makeStmt(StmtKind::PRINT, $3, yylineno);
     }
-  | INSTR_LIST PRINT '(' EXPR ')' ';'
+  | TYPEOF '(' EXPR ')' ';'
     {
-      // De ex. apelezi o funcție Print(...) dacă ai definit-o
-      Print(evaluateTree($4, yylineno), yylineno);
+      $$ = makeStmt(StmtKind::TYPEOF, $3, yylineno);
     }
-  | INSTR_LIST TYPEOF '(' EXPR ')' ';'
+  | SPAWN EXPR ';'
     {
-      TypeOf(evaluateTree($4, yylineno), yylineno);
+      // Ex: spawn f(x); => f ruleaza intr-un task nou
+      $$ = makeSpawnStmt($2, $1);
     }
   ;
 
@@ -196,11 +301,14 @@ INSTR_LIST
 INSTR 
   : LVALUE ASSIGN EXPR 
     {
-      updateVarValue(lvalue, evaluateTree($3, yylineno), yylineno);
+      checkAssign(lvalue, $3->treeType, yylineno);
+      $$ = makeStmt(StmtKind::ASSIGN, $3, yylineno);
+      $$->target = lvalue;
     }
   | EXPR
     {
       // ex: apel de funcție
+      $$ = makeStmt(StmtKind::EXPR, $1, yylineno);
     }
   ;
 
@@ -208,16 +316,22 @@ INSTR
 LVALUE
   : ID
     {
-      lvalue = $1;
+      lvalue = LValue();
+      lvalue.name  = $1;
     }
   | ID '[' EXPR ']'
     {
-      lvalue = std::string($1) + "[" + evaluateTree($3, yylineno).resultStr + "]";
+      lvalue = LValue();
+      lvalue.name  = $1;
+      lvalue.index = $3;
     }
   | ID '.' ID
     {
-      // obj.field => lvalue = "obj.field" (dacă vrei)
-      lvalue = std::string($1) + "." + std::string($3);
+      // obj.field => atributul din clasa obiectului
+      lvalue = LValue();
+      lvalue.name   = $3;
+      lvalue.var    = isIdInClass($1, $3, yylineno);
+      lvalue.object = getObject($1, yylineno);
     }
   ;
 
@@ -262,10 +376,12 @@ EXPR
   | VAR_CHAR
     {
       $$ = buildTree($1, Category::CHAR, nullptr, nullptr, yylineno);
+      free($1);   // copiat de strndup in lexer
     }
   | VAR_STRING
     {
       $$ = buildTree($1, Category::STRING, nullptr, nullptr, yylineno);
+      free($1);
     }
   | EXPR AND EXPR
     {
@@ -305,28 +421,33 @@ EXPR
     }
   | ID '(' ARGS_LIST ')'
     {
-      compareParamWithArgs($1, args, "global", yylineno);
-      $$ = buildTree($1, convertStringToEnum(getFuncType($1)), nullptr, nullptr, yylineno);
+      int f = compareParamWithArgs($1, argsToString(*$3), SYM_GLOBAL, yylineno);
+      $$ = buildCallTree(f, $3, yylineno);
     }
   | ID
     {
-      $$ = buildTree($1, Category::IDENTIFIER, nullptr, nullptr, yylineno);
+      $$ = buildVarTree($1, nullptr, yylineno);
     }
   | ID '[' EXPR ']'
     {
-      std::string rvalue = std::string($1) + "[" + evaluateTree($3, yylineno).resultStr + "]";
-      $$ = buildTree(rvalue, Category::IDENTIFIER, nullptr, nullptr, yylineno);
+      $$ = buildVarTree($1, $3, yylineno);
     }
   | ID '.' ID '(' ARGS_LIST ')'
     {
-      compareParamWithArgs($3, args, getTypeOfObject($1, yylineno), yylineno);
-      isMemberInClass($1, $3, yylineno);
-      $$ = buildTree($3, Category::OTHER, nullptr, nullptr, yylineno);
+      int ch = findChannel($1);
+      if (ch >= 0) {
+        // c.send(x) / c.recv(v) / c.close()
+        $$ = buildChannelTree(ch, $3, $5, yylineno);
+      } else {
+        int f = compareParamWithArgs($3, argsToString(*$5), getTypeOfObject($1, yylineno).name, yylineno);
+        isMemberInClass($1, $3, yylineno);
+        $$ = buildCallTree(f, $5, yylineno);
+        $$->object = getObject($1, yylineno);
+      }
     }
   | ID '.' ID
     {
-      isIdInClass($1, $3, yylineno);
-      $$ = buildTree("0", Category::OTHER, nullptr, nullptr, yylineno);
+      $$ = buildFieldTree($1, $3, yylineno);
     }
   ;
 
@@ -338,37 +459,114 @@ COND
 /* Instructiuni de control */
 if 
   : IF '(' COND ')' '{' INSTR_LIST '}'
+    {
+      $$ = makeStmt(StmtKind::IF, $3, $1);
+      $$->body = std::move(*$6);
+      delete $6;
+    }
   | IF '(' COND ')' '{' INSTR_LIST '}' ELSE '{' INSTR_LIST '}'
+    {
+      $$ = makeStmt(StmtKind::IF, $3, $1);
+      $$->body     = std::move(*$6);
+      $$->elseBody = std::move(*$10);
+      delete $6;
+      delete $10;
+    }
   ;
 
 while 
   : WHILE '(' COND ')' '{' INSTR_LIST '}'
+    {
+      $$ = makeStmt(StmtKind::WHILE, $3, $1);
+      $$->body = std::move(*$6);
+      delete $6;
+    }
   ;
 
 do 
   : DO '{' INSTR_LIST '}' WHILE '(' COND ')' ';'
+    {
+      $$ = makeStmt(StmtKind::DO_WHILE, $7, $1);
+      $$->body = std::move(*$3);
+      delete $3;
+    }
   ;
 
 for 
   : FOR '(' INSTR ';' COND ';' INSTR ')' '{' INSTR_LIST '}'
+    {
+      $$ = makeStmt(StmtKind::FOR, $5, $1);
+      $$->init = $3;
+      $$->step = $7;
+      $$->body = std::move(*$10);
+      delete $10;
+    }
+  | PARALLEL_HEAD '{' INSTR_LIST '}'
+    {
+      $$ = $1;
+      $$->body = std::move(*$3);
+      delete $3;
+      checkParallelFor($$);
+    }
+  ;
+
+/* parallel(dynamic, 4) for (i = 0; i < n; i = i + 1) reduce(+: s, max: m) { ... }
+   Clauzele se aduna in parallelSpec (ca lvalue) si trec in instructiune inainte
+   de corp. */
+PARALLEL_HEAD
+  : PARALLEL SCHEDULE FOR '(' INSTR ';' COND ';' INSTR ')' REDUCTIONS
+    {
+      $$ = makeParallelForStmt($5, $7, $9, $1);
+    }
+  ;
+
+SCHEDULE
+  : /* epsilon */           { parallelSpec = ParallelSpec(); }
+  | '(' ID ')'              { parallelSpec = ParallelSpec(); setSchedule($2, yylineno); }
+  | '(' ID ',' VAR_INT ')'
+    {
+      parallelSpec = ParallelSpec();
+      setSchedule($2, yylineno);
+      setChunk($4, yylineno);
+    }
+  ;
+
+REDUCTIONS
+  : /* epsilon */
+  | ID '(' REDUCTION_LIST ')'
+    {
+      if (symbols.name($1) != "reduce") {
+        std::cerr << "[Line " << yylineno << "] Error: Expected reduce(...) after the parallel loop header\n";
+        abortCompilation();
+      }
+    }
+  ;
+
+REDUCTION_LIST
+  : REDUCTION
+  | REDUCTION_LIST ',' REDUCTION
+  ;
+
+REDUCTION
+  : '+' ':' ID { addReduction('+', $3, yylineno); }
+  | '*' ':' ID { addReduction('*', $3, yylineno); }
+  | ID ':' ID  { addReduction(reductionOp($1, yylineno), $3, yylineno); }
   ;
 
 /* ARGS_LIST = argumentele unui apel de funcție */
 ARGS_LIST
-  : EXPR ',' 
+  : EXPR ',' ARGS_LIST
     {
-      // fiindcă args e std::string, facem concatenare
-      args += convertEnumToString(evaluateTree($1, yylineno).treeType);
-      args += ", ";
+      $$ = $3;
+      $$->insert($$->begin(), $1);
     }
-    ARGS_LIST
   | EXPR
     {
-      args += convertEnumToString(evaluateTree($1, yylineno).treeType);
+      $$ = new std::vector<AST*>{ $1 };
     }
   | /* epsilon */
     {
-      args += "-";
+      $$ = new std::vector<AST*>();
     }
   ;
 
@@ -376,23 +574,222 @@ ARGS_LIST
 
 void yyerror(const char * s) {
     std::cerr << "{error} " << s << " at line: " << yylineno << " :(" << std::endl;
+    for (auto it = importTrail.rbegin(); it != importTrail.rend(); ++it)
+        std::cerr << "  in module " << *it << "\n";
 }
 
 
+struct yy_buffer_state;
+yy_buffer_state* yy_scan_bytes(const char* bytes, int len);
+void yy_delete_buffer(yy_buffer_state* buffer);
+
+#ifdef LFAC_FUZZ
+
+// Intrarea harness-urilor de fuzzing (fuzz_parser.cpp, fuzz_expr.cpp, fuzz_parallel.cpp):
+// compileaza si executa programul din buffer. Tot ce se scrie pe std::cout ajunge in
+// output, std::cerr se ignora. Intoarce false daca programul a fost respins sau oprit
+// de o eroare.
+bool compileAndRun(const char* data, size_t size, std::string& output)
+{
+    resetCompiler();
+    yylineno         = 1;
+    throwOnError     = true;
+    cooperativeTasks = true;
+
+    std::ostringstream out;
+    std::streambuf* oldOut = std::cout.rdbuf(out.rdbuf());
+    std::streambuf* oldErr = std::cerr.rdbuf(nullptr);
+    yy_buffer_state* buffer = yy_scan_bytes(data, static_cast<int>(size));
+
+    bool ok = false;
+    try {
+        ok = (yyparse() == 0);
+        if (ok) {
+            runMain();
+        }
+    } catch (const CompilationAborted&) {
+        ok = false;
+    }
+
+    yy_delete_buffer(buffer);
+    std::cout.rdbuf(oldOut);   // rdbuf() sterge si starea de eroare a stream-ului
+    std::cerr.rdbuf(oldErr);
+    output = out.str();
+    return ok;
+}
+#else
+// Parser-ul push e impur: token-ul vine prin yychar, valoarea lui prin yylval
+static int replPush(yypstate* ps, int token) {
+    yychar = token;
+    return yypush_parse(ps);
+}
+
+static yypstate* replNewParser() {
+    yypstate* ps = yypstate_new();
+    replPush(ps, REPL_START);
+    return ps;
+}
+
+// Sesiunea interactiva: fiecare linie e scanata o singura data, iar token-urile ei
+// merg direct in parser-ul push, care isi pastreaza starea intre linii. Cand
+// parantezele sunt inchise la sfarsitul liniei trimitem REPL_END si elementul
+// se executa. La o eroare pornim un parser nou si anulam elementul neterminat.
+int runRepl() {
+    throwOnError     = true;
+    cooperativeTasks = true;   // spawn e refuzat oricum la rulare, cu mesajul lui
+    replCommit();
+    yypstate* ps = replNewParser();
+    int depth = 0;   // paranteze ( [ { inca deschise
+
+    std::string line;
+    std::cout << ">>> " << std::flush;
+    while (std::getline(std::cin, line)) {
+        line += '\n';
+        yy_buffer_state* buffer = yy_scan_bytes(line.data(), static_cast<int>(line.size()));
+
+        int status = YYPUSH_MORE;
+        try {
+            int token;
+            while (status == YYPUSH_MORE && (token = yylex()) != 0) {
+                if (token == '(' || token == '[' || token == '{') depth++;
+                if (token == ')' || token == ']' || token == '}') depth--;
+                status = replPush(ps, token);
+            }
+            if (status == YYPUSH_MORE && depth <= 0) {
+                status = replPush(ps, REPL_END);
+            }
+        } catch (const CompilationAborted&) {
+            status = 1;   // ca la o eroare de sintaxa
+        }
+        yy_delete_buffer(buffer);
+
+        if (status != YYPUSH_MORE) {
+            yypstate_delete(ps);
+            replRollback();
+            ps = replNewParser();
+            depth = 0;
+        }
+        std::cout << (depth > 0 ? "... " : ">>> ") << std::flush;
+    }
+
+    yypstate_delete(ps);
+    std::cout << std::endl;
+    return 0;
+}
+
 int main(int argc, char **argv) {
     
+    // ./compiler [--profile] [--prune] [-O0|-O1|-O2] [--raw-output] [--output=fisier | --output-fd=N]
+    //            [--threads=N] [--gc-stats] [--gc-nursery=KiB] [--cooperative-tasks] fisier
+    //   sau  ./compiler --repl
+    bool prune = false;
+    bool gcStats = false;
+    int  optLevel = 0;
+    std::string outputFile;
+    int  outputFd = -1;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--profile") {
+            profiler.enabled = true;
+        } else if (arg == "--prune") {
+            prune = true;
+        } else if (arg == "-O0" || arg == "-O1" || arg == "-O2") {
+            optLevel = arg[2] - '0';
+        } else if (arg == "--raw-output") {
+            programOutput.raw = true;
+        } else if (arg.rfind("--output=", 0) == 0) {
+            outputFile = arg.substr(9);
+        } else if (arg.rfind("--output-fd=", 0) == 0) {
+            // tot textul de dupa '=' trebuie sa fie numarul: "--output-fd=" sau "x" nu devin fd 0
+            const char* first = arg.c_str() + 12;
+            const char* last = arg.c_str() + arg.size();
+            auto parsed = std::from_chars(first, last, outputFd);
+            if (first == last || parsed.ec != std::errc() || parsed.ptr != last || outputFd < 0) {
+                std::cerr << "--output-fd needs a file descriptor >= 0\n";
+                return 1;
+            }
+        } else if (arg.rfind("--threads=", 0) == 0) {
+            parallelThreads = std::atoi(arg.c_str() + 10);
+            if (parallelThreads < 1) {
+                std::cerr << "--threads needs a number of threads > 0\n";
+                return 1;
+            }
+        } else if (arg == "--cooperative-tasks") {
+            cooperativeTasks = true;
+        } else if (arg == "--gc-stats") {
+            gcStats = true;
+        } else if (arg.rfind("--gc-nursery=", 0) == 0) {
+            int kib = std::atoi(arg.c_str() + 13);
+            if (kib < 1) {
+                std::cerr << "--gc-nursery needs a size in KiB > 0\n";
+                return 1;
+            }
+            RtString::heap.setNurserySize(static_cast<std::size_t>(kib) * 1024);
+        } else if (arg == "--repl") {
+            return runRepl();
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            // o optiune scrisa gresit (--prof, -O3) nu trebuie deschisa ca fisier sursa
+            std::cerr << "Unknown option " << arg << "\n";
+            return 1;
+        } else {
+            yyin = fopen(argv[i], "r");
+            if (!yyin) {
+                std::cerr << "Cannot open " << arg << "\n";
+                return 1;
+            }
+            sourceFile = argv[i];
+        }
+    }
+    importsEnabled = true;
+
+    if (!outputFile.empty() && outputFd >= 0) {
+        std::cerr << "--output and --output-fd cannot be combined\n";
+        return 1;
+    }
+    if (!outputFile.empty()) {
+        if (!programOutput.toFile(outputFile)) {
+            std::cerr << "Cannot open " << outputFile << "\n";
+            return 1;
+        }
+    } else if (outputFd >= 0) {
+        programOutput.toFd(outputFd);
+    } else {
+        programOutput.bufferStdout();
+    }
+
     std::ofstream ffunc("functions.txt");
 
-    if (argc > 1) {
-        yyin = fopen(argv[1], "r");
+    if (yyparse() == 0) {
+        if (optLevel > 0) {
+            optimizeProgram(optLevel);
+        }
+        if (prune) {
+            std::ofstream fprune("prune.txt");
+            pruneUnused(fprune);
+        }
+        runMain();
     }
 
-    yyparse();
-
   
     printFunc(ffunc);
 
     
     ffunc.close();
+
+    if (profiler.enabled) {
+        std::ofstream fprof("profile.txt");
+        profiler.writeReport(fprof);
+        std::ofstream ffold("profile.folded");
+        profiler.writeFolded(ffold);
+    }
+    if (gcStats) {
+        std::ofstream fgc("gc.txt");
+        RtString::heap.writeReport(fgc);
+    }
+    if (!programOutput.finish()) {
+        std::cerr << "Error: could not write the program output.\n";
+        return 1;
+    }
     return 0;
 }
+#endif
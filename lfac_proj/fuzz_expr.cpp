@@ -0,0 +1,273 @@
+// Testare diferentiala pentru expresii (libFuzzer / AFL++), vezi README.
+// Din bytes-ii de intrare se genereaza o expresie int / bool bine tipata, se
+// compileaza programul "int main() { Print(expresie); }" si rezultatul lui Print
+// se compara cu un evaluator de referinta, scris separat de compilator: lucreaza
+// direct pe arborele generat, fara AST, fara texte si fara std::stoi.
+// La orice diferenta se afiseaza programul si se apeleaza abort().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+
+bool compileAndRun(const char* data, std::size_t size, std::string& output); // compiler.y
+
+namespace
+{
+
+// Nivelurile de precedenta, ca in compiler.y (mai mare = leaga mai tare)
+enum Prec
+{
+    PREC_OR = 1,
+    PREC_AND,
+    PREC_EQ,
+    PREC_REL,
+    PREC_ADD,
+    PREC_MUL,
+    PREC_ATOM
+};
+
+struct Node
+{
+    bool        isBool = false;
+    std::string op;                 // "" pentru literali, "not" pentru not(...)
+    std::int32_t intValue  = 0;
+    bool         boolValue = false;
+    std::unique_ptr<Node> left, right;
+};
+
+// Citeste bytes-ii inputului; dupa ce se termina, intoarce mereu 0
+struct ByteReader
+{
+    const std::uint8_t* data;
+    std::size_t         size;
+    std::size_t         pos = 0;
+
+    unsigned next()
+    {
+        return pos < size ? data[pos++] : 0;
+    }
+};
+
+constexpr int MAX_DEPTH = 10;
+
+std::unique_ptr<Node> genInt(ByteReader& in, int depth);
+std::unique_ptr<Node> genBool(ByteReader& in, int depth);
+
+std::unique_ptr<Node> intLiteral(ByteReader& in)
+{
+    auto n = std::make_unique<Node>();
+    unsigned pick = in.next();
+    if (pick % 16 == 15)        // capetele intervalului, pt. depasiri
+        n->intValue = (pick & 16) ? INT32_MAX : INT32_MIN;
+    else
+        n->intValue = static_cast<std::int32_t>(in.next()) - 128;
+    return n;
+}
+
+std::unique_ptr<Node> genInt(ByteReader& in, int depth)
+{
+    static const char* const ops[] = {"+", "-", "*", "/", "%"};
+    unsigned pick = in.next();
+    if (depth >= MAX_DEPTH || pick % 3 == 0)
+        return intLiteral(in);
+
+    auto n = std::make_unique<Node>();
+    n->op    = ops[(pick / 3) % 5];
+    n->left  = genInt(in, depth + 1);
+    n->right = genInt(in, depth + 1);
+    return n;
+}
+
+std::unique_ptr<Node> genBool(ByteReader& in, int depth)
+{
+    static const char* const relOps[] = {"<", ">", "<=", ">=", "==", "!="};
+    auto n = std::make_unique<Node>();
+    n->isBool = true;
+
+    unsigned pick = in.next();
+    if (depth >= MAX_DEPTH)
+        pick = 0;
+    switch (pick % 7)
+    {
+        case 0:
+            n->boolValue = (pick & 8) != 0;
+            break;
+        case 1:
+            n->op   = "not";
+            n->left = genBool(in, depth + 1);
+            break;
+        case 2:
+        case 3:
+            n->op    = (pick % 7 == 2) ? "&&" : "||";
+            n->left  = genBool(in, depth + 1);
+            n->right = genBool(in, depth + 1);
+            break;
+        case 4:
+            n->op    = (pick & 8) ? "==" : "!=";
+            n->left  = genBool(in, depth + 1);
+            n->right = genBool(in, depth + 1);
+            break;
+        default:
+            n->op    = relOps[(pick / 7) % 6];
+            n->left  = genInt(in, depth + 1);
+            n->right = genInt(in, depth + 1);
+            break;
+    }
+    return n;
+}
+
+int precedence(const Node& n)
+{
+    if (n.op.empty() || n.op == "not")
+        return PREC_ATOM;
+    if (n.op == "||") return PREC_OR;
+    if (n.op == "&&") return PREC_AND;
+    if (n.op == "==" || n.op == "!=") return PREC_EQ;
+    if (n.op == "+" || n.op == "-") return PREC_ADD;
+    if (n.op == "*" || n.op == "/" || n.op == "%") return PREC_MUL;
+    return PREC_REL;
+}
+
+// Textul expresiei, cu paranteze doar unde le cere precedenta (toti operatorii
+// sunt asociativi la stanga), plus cateva in plus, alese din input
+void print(const Node& n, ByteReader& in, std::string& out)
+{
+    if (n.op.empty())
+    {
+        out += n.isBool ? (n.boolValue ? "true" : "false") : std::to_string(n.intValue);
+        return;
+    }
+    if (n.op == "not")
+    {
+        out += "not(";
+        print(*n.left, in, out);
+        out += ")";
+        return;
+    }
+
+    int prec = precedence(n);
+    auto child = [&](const Node& c, bool isRight)
+    {
+        int  cp     = precedence(c);
+        bool parens = cp < prec || (isRight && cp == prec) || (cp != PREC_ATOM && in.next() % 5 == 0);
+        if (parens) out += "(";
+        print(c, in, out);
+        if (parens) out += ")";
+    };
+    child(*n.left, false);
+    out += " " + n.op + " ";
+    child(*n.right, true);
+}
+
+// Rezultatul de referinta; false daca evaluarea trebuie sa dea eroare (impartire la 0)
+struct Value
+{
+    std::int32_t i = 0;
+    bool         b = false;
+};
+
+bool evalRef(const Node& n, Value& v)
+{
+    if (n.op.empty())
+    {
+        v.i = n.intValue;
+        v.b = n.boolValue;
+        return true;
+    }
+
+    Value l, r;
+    if (n.op == "not")
+    {
+        if (!evalRef(*n.left, l)) return false;
+        v.b = !l.b;
+        return true;
+    }
+    if (n.op == "&&" || n.op == "||")   // scurtcircuitare: dreapta poate sa nu se evalueze
+    {
+        if (!evalRef(*n.left, l)) return false;
+        if (l.b == (n.op == "||"))
+        {
+            v.b = l.b;
+            return true;
+        }
+        if (!evalRef(*n.right, r)) return false;
+        v.b = r.b;
+        return true;
+    }
+
+    if (!evalRef(*n.left, l) || !evalRef(*n.right, r))
+        return false;
+
+    if (n.left->isBool)                 // == / != intre bool-uri
+    {
+        v.b = (n.op == "==") ? l.b == r.b : l.b != r.b;
+        return true;
+    }
+    if (n.isBool)
+    {
+        v.b = (n.op == "<")  ? l.i <  r.i :
+              (n.op == ">")  ? l.i >  r.i :
+              (n.op == "<=") ? l.i <= r.i :
+              (n.op == ">=") ? l.i >= r.i :
+              (n.op == "==") ? l.i == r.i : l.i != r.i;
+        return true;
+    }
+
+    // aritmetica pe 32 de biti cu wrap-around, facuta pe unsigned
+    std::uint32_t a = static_cast<std::uint32_t>(l.i), b = static_cast<std::uint32_t>(r.i);
+    if (n.op == "+") { v.i = static_cast<std::int32_t>(a + b); return true; }
+    if (n.op == "-") { v.i = static_cast<std::int32_t>(a - b); return true; }
+    if (n.op == "*") { v.i = static_cast<std::int32_t>(a * b); return true; }
+
+    if (r.i == 0)
+        return false;
+    if (l.i == INT32_MIN && r.i == -1)  // singurul caz in care catul nu incape
+        v.i = (n.op == "/") ? INT32_MIN : 0;
+    else
+        v.i = (n.op == "/") ? l.i / r.i : l.i % r.i;
+    return true;
+}
+
+// Textul afisat de Print in output ("... The result is: X"), sau "" daca lipseste
+std::string printedResult(const std::string& output)
+{
+    static const std::string marker = "The result is: ";
+    auto pos = output.find(marker);
+    if (pos == std::string::npos)
+        return "";
+    pos += marker.size();
+    return output.substr(pos, output.find('\n', pos) - pos);
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    ByteReader in{data, size};
+    std::unique_ptr<Node> expr = (in.next() & 1) ? genBool(in, 0) : genInt(in, 0);
+
+    std::string text;
+    print(*expr, in, text);
+    std::string program = "int main() {\n    Print(" + text + ");\n}\n";
+
+    Value expected;
+    bool  expectOk = evalRef(*expr, expected);
+    std::string expectedText = !expectOk ? "" :
+                               expr->isBool ? (expected.b ? "true" : "false") : std::to_string(expected.i);
+
+    std::string output;
+    bool ok = compileAndRun(program.data(), program.size(), output);
+    std::string got = ok ? printedResult(output) : "";
+
+    if (ok != expectOk || got != expectedText)
+    {
+        std::fprintf(stderr, "Differential mismatch for program:\n%s\nexpected: %s\ngot:      %s\n",
+                     program.c_str(), expectOk ? expectedText.c_str() : "<error>",
+                     ok ? got.c_str() : "<error>");
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+// Driver pentru harness-urile de fuzzing fara libFuzzer (g++, AFL clasic, reproducere):
+//   ./fuzz_parser_run [-timeout=N] [-rss_limit_mb=N] fisier...   ruleaza fiecare fisier
+//   ./fuzz_parser_run [optiuni] < input                          un singur input (AFL: @@ sau stdin)
+// Optiunile au numele celor din libFuzzer. Un input care depaseste timpul e oprit de
+// SIGALRM, unul care depaseste memoria primeste bad_alloc => crash, ca in libFuzzer.
+
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size);
+
+namespace
+{
+
+unsigned timeoutSec = 5;
+std::string current = "<stdin>";
+
+void onTimeout(int)
+{
+    const char msg[] = "fuzz_main: timeout on input ";
+    (void)!write(STDERR_FILENO, msg, sizeof(msg) - 1);
+    (void)!write(STDERR_FILENO, current.data(), current.size());
+    (void)!write(STDERR_FILENO, "\n", 1);
+    std::abort();
+}
+
+void runOne(const std::string& input)
+{
+    alarm(timeoutSec);
+    LLVMFuzzerTestOneInput(reinterpret_cast<const std::uint8_t*>(input.data()), input.size());
+    alarm(0);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::vector<std::string> files;
+    long rssLimitMb = 2048;
+    for (int i = 1; i < argc; i++)
+    {
+        if (std::strncmp(argv[i], "-timeout=", 9) == 0)
+            timeoutSec = static_cast<unsigned>(std::atoi(argv[i] + 9));
+        else if (std::strncmp(argv[i], "-rss_limit_mb=", 14) == 0)
+            rssLimitMb = std::atol(argv[i] + 14);
+        else
+            files.push_back(argv[i]);
+    }
+
+    // fara sanitizere: limita de spatiu de adrese (ASan rezerva mult, deci acolo 0 = fara limita)
+    if (rssLimitMb > 0)
+    {
+        rlimit limit;
+        limit.rlim_cur = limit.rlim_max = static_cast<rlim_t>(rssLimitMb) << 20;
+        setrlimit(RLIMIT_AS, &limit);
+    }
+    std::signal(SIGALRM, onTimeout);
+
+    if (files.empty())
+    {
+        std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
+        runOne(input);
+        return 0;
+    }
+
+    for (const std::string& file : files)
+    {
+        std::ifstream in(file, std::ios::binary);
+        if (!in)
+        {
+            std::cerr << "Cannot open " << file << "\n";
+            return 1;
+        }
+        current = file;
+        runOne(std::string((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>()));
+    }
+    std::cout << "Executed " << files.size() << " inputs\n";
+    return 0;
+}
@@ -0,0 +1,357 @@
+// Testare diferentiala pentru parallel for (libFuzzer / AFL++), vezi README.
+// Din bytes-ii de intrare se genereaza o bucla al carei corp e acceptat de
+// parallel for: declaratii int / float / bool, atribuiri, a[i] = e, reduceri,
+// if / else si bucle interioare cu contor local. Acelasi program se compileaza o
+// data cu `for` si o data cu `parallel ... for ... reduce(...)`. Corpul paralel
+// ruleaza in kernel (evaluatorul lui propriu), cel secvential in interpretor, deci
+// valorile afisate dupa bucla (contorul, reducerile, array-urile scrise) trebuie sa
+// fie aceleasi, iar o eroare (ex. impartire la zero) trebuie sa apara in ambele.
+// Inputurile oprite de FUZZ_BUDGET se ignora.
+// La orice diferenta se afiseaza programele si se apeleaza abort().
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+bool compileAndRun(const char* data, std::size_t size, std::string& output); // compiler.y
+extern long long fuzzBudget;   // compiler.hpp; < 0 daca executia a fost oprita de FUZZ_BUDGET
+
+namespace
+{
+
+constexpr int SIZE      = 16;   // a, b (int) si f, g (float); bucla ramane in [0, SIZE)
+constexpr int MAX_DEPTH = 3;    // adancimea expresiilor
+constexpr int MAX_STMTS = 6;    // instructiuni per bloc (bugetul de evaluare al fuzz-ului)
+constexpr int MAX_NEST  = 2;    // if / bucle imbricate
+
+// Citeste bytes-ii inputului; dupa ce se termina, intoarce mereu 0
+struct ByteReader
+{
+    const std::uint8_t* data;
+    std::size_t         size;
+    std::size_t         pos = 0;
+
+    unsigned next()
+    {
+        return pos < size ? data[pos++] : 0;
+    }
+};
+
+// Variabilele locale declarate pana acum direct in corp (se pot citi si atribui)
+struct Scope
+{
+    std::vector<std::string> ints, floats, bools;
+    int next = 0;   // pt. nume noi: t0, t1, ...
+
+    std::string fresh(char prefix)
+    {
+        return prefix + std::to_string(next++);
+    }
+};
+
+std::string pickFrom(ByteReader& in, const std::vector<std::string>& names)
+{
+    return names[in.next() % names.size()];
+}
+
+std::string intExpr(ByteReader& in, const Scope& sc, int depth)
+{
+    // impartirile mai rar: cu ele, multe programe s-ar opri cu impartire la zero
+    static const char* const ops[] = {" + ", " - ", " * ", " + ", " - ", " * ", " / ", " % "};
+    unsigned pick = in.next();
+    if (depth >= MAX_DEPTH || pick % 3 == 0)
+    {
+        switch ((pick / 3) % 6)
+        {
+            case 0:  return "i";
+            case 1:  return "b[i]";
+            case 2:  if (!sc.ints.empty()) return pickFrom(in, sc.ints);
+                     return "i";
+            case 3:  return "2147483647";   // pt. depasiri
+            default: return std::to_string(in.next() % 100);
+        }
+    }
+    return "(" + intExpr(in, sc, depth + 1) + ops[(pick / 3) % 8] + intExpr(in, sc, depth + 1) + ")";
+}
+
+std::string floatExpr(ByteReader& in, const Scope& sc, int depth)
+{
+    static const char* const ops[]      = {" + ", " - ", " * ", " / "};
+    static const char* const literals[] = {"0.5", "1.25", "3.0", "0.1", "100.0", "0.0"};
+    unsigned pick = in.next();
+    if (depth >= MAX_DEPTH || pick % 3 == 0)
+    {
+        switch ((pick / 3) % 4)
+        {
+            case 0:  return "g[i]";
+            case 1:  if (!sc.floats.empty()) return pickFrom(in, sc.floats);
+                     return "g[i]";
+            default: return literals[in.next() % 6];
+        }
+    }
+    return "(" + floatExpr(in, sc, depth + 1) + ops[(pick / 3) % 4] + floatExpr(in, sc, depth + 1) + ")";
+}
+
+std::string boolExpr(ByteReader& in, const Scope& sc, int depth)
+{
+    static const char* const relOps[] = {" < ", " > ", " <= ", " >= ", " == ", " != "};
+    unsigned pick = in.next();
+    if (depth >= MAX_DEPTH)
+        pick = 0;
+    switch (pick % 7)
+    {
+        case 0:
+            if (!sc.bools.empty() && (pick & 8))
+                return pickFrom(in, sc.bools);
+            return (pick & 16) ? "true" : "false";
+        case 1:
+            return "not(" + boolExpr(in, sc, depth + 1) + ")";
+        case 2:
+        case 3:
+            return "(" + boolExpr(in, sc, depth + 1) + (pick % 7 == 2 ? " && " : " || ") +
+                   boolExpr(in, sc, depth + 1) + ")";
+        case 4:
+            return "(" + floatExpr(in, sc, depth + 1) + relOps[(pick / 7) % 6] + floatExpr(in, sc, depth + 1) + ")";
+        default:
+            return "(" + intExpr(in, sc, depth + 1) + relOps[(pick / 7) % 6] + intExpr(in, sc, depth + 1) + ")";
+    }
+}
+
+void block(ByteReader& in, Scope& sc, int nest, const std::string& indent, std::string& out);
+
+// O instructiune; declaratiile (si contoarele buclelor interioare) doar direct in corp
+void statement(ByteReader& in, Scope& sc, int nest, const std::string& indent, std::string& out)
+{
+    bool top  = nest == 0;
+    unsigned pick = in.next() % (top ? 14 : 10);
+    if (nest >= MAX_NEST && pick >= 8)
+        pick = 0;
+
+    switch (pick)
+    {
+        case 0:
+            out += indent + "a[i] = " + intExpr(in, sc, 0) + ";\n";
+            break;
+        case 1:
+            out += indent + "f[i] = " + floatExpr(in, sc, 0) + ";\n";
+            break;
+        case 2:
+            out += indent + "s = s + " + intExpr(in, sc, 0) + ";\n";
+            break;
+        case 3:
+            out += indent + "p = p * " + intExpr(in, sc, 0) + ";\n";
+            break;
+        case 4:
+        {
+            std::string e = intExpr(in, sc, 0);
+            if (in.next() & 1)
+                out += indent + "if (" + e + " < lo) { lo = " + e + "; }\n";
+            else
+                out += indent + "if (" + e + " > hi) { hi = " + e + "; }\n";
+            break;
+        }
+        case 5:
+            if (!sc.ints.empty())
+            {
+                out += indent + pickFrom(in, sc.ints) + " = " + intExpr(in, sc, 0) + ";\n";
+                break;
+            }
+            [[fallthrough]];
+        case 6:
+            if (!sc.floats.empty())
+            {
+                out += indent + pickFrom(in, sc.floats) + " = " + floatExpr(in, sc, 0) + ";\n";
+                break;
+            }
+            [[fallthrough]];
+        case 7:
+            if (!sc.bools.empty())
+            {
+                out += indent + pickFrom(in, sc.bools) + " = " + boolExpr(in, sc, 0) + ";\n";
+                break;
+            }
+            out += indent + "a[i] = " + intExpr(in, sc, 0) + ";\n";
+            break;
+        case 8:
+        case 9:
+            out += indent + "if (" + boolExpr(in, sc, 0) + ") {\n";
+            block(in, sc, nest + 1, indent + "    ", out);
+            out += indent + "}";
+            if (pick == 9)
+            {
+                out += " else {\n";
+                block(in, sc, nest + 1, indent + "    ", out);
+                out += indent + "}";
+            }
+            out += "\n";
+            break;
+        case 10:
+        {
+            std::string name = sc.fresh('t');
+            out += indent + "int " + name + " = " + intExpr(in, sc, 0) + ";\n";
+            sc.ints.push_back(name);
+            break;
+        }
+        case 11:
+        {
+            std::string name = sc.fresh('t');
+            if (in.next() & 1)
+            {
+                out += indent + "float " + name + " = " + floatExpr(in, sc, 0) + ";\n";
+                sc.floats.push_back(name);
+            }
+            else
+            {
+                out += indent + "bool " + name + " = " + boolExpr(in, sc, 0) + ";\n";
+                sc.bools.push_back(name);
+            }
+            break;
+        }
+        default:
+        {
+            // bucla interioara cu cel mult 4 pasi; corpul nu vede contorul
+            std::string j     = sc.fresh('j');
+            std::string count = std::to_string(in.next() % 5);
+            out += indent + "int " + j + " = 0;\n";
+            switch (in.next() % 3)
+            {
+                case 0:
+                    out += indent + "for (" + j + " = 0; " + j + " < " + count + "; " + j + " = " + j + " + 1) {\n";
+                    block(in, sc, nest + 1, indent + "    ", out);
+                    out += indent + "}\n";
+                    break;
+                case 1:
+                    out += indent + "while (" + j + " < " + count + ") {\n";
+                    block(in, sc, nest + 1, indent + "    ", out);
+                    out += indent + "    " + j + " = " + j + " + 1;\n";
+                    out += indent + "}\n";
+                    break;
+                default:
+                    out += indent + "do {\n";
+                    block(in, sc, nest + 1, indent + "    ", out);
+                    out += indent + "    " + j + " = " + j + " + 1;\n";
+                    out += indent + "} while (" + j + " < " + count + ");\n";
+                    break;
+            }
+            sc.ints.push_back(j);
+            break;
+        }
+    }
+}
+
+void block(ByteReader& in, Scope& sc, int nest, const std::string& indent, std::string& out)
+{
+    int count = 1 + static_cast<int>(in.next() % MAX_STMTS);
+    for (int k = 0; k < count; k++)
+        statement(in, sc, nest, indent, out);
+}
+
+// Valorile afisate de Print, in ordine (liniile "... The result is: X")
+std::vector<std::string> printedResults(const std::string& output)
+{
+    static const std::string marker = "The result is: ";
+    std::vector<std::string> results;
+    for (std::size_t pos = output.find(marker); pos != std::string::npos; pos = output.find(marker, pos))
+    {
+        pos += marker.size();
+        results.push_back(output.substr(pos, output.find('\n', pos) - pos));
+    }
+    return results;
+}
+
+std::string joined(const std::vector<std::string>& lines)
+{
+    std::string text;
+    for (const std::string& line : lines)
+        text += line + " ";
+    return text;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    ByteReader in{data, size};
+
+    // antetul: crescator (< / <=) sau descrescator (> / >=), pas 1..3, in [0, SIZE)
+    int lo   = static_cast<int>(in.next() % 4);
+    int hi   = lo + static_cast<int>(in.next() % (SIZE - lo));
+    int step = 1 + static_cast<int>(in.next() % 3);
+    std::string header;
+    switch (in.next() % 4)
+    {
+        case 0:  header = "for (i = " + std::to_string(lo) + "; i < " + std::to_string(hi + 1) + "; i = i + "; break;
+        case 1:  header = "for (i = " + std::to_string(lo) + "; i <= " + std::to_string(hi) + "; i = i + "; break;
+        case 2:  header = "for (i = " + std::to_string(hi) + "; i >= " + std::to_string(lo) + "; i = i - "; break;
+        default: header = "for (i = " + std::to_string(hi) + "; i > " + std::to_string(lo) + "; i = i - "; break;
+    }
+    header += std::to_string(step) + ")";
+
+    static const char* const schedules[] = {"parallel ", "parallel(static) ", "parallel(static, 2) ",
+                                            "parallel(dynamic) ", "parallel(dynamic, 3) "};
+    const char* schedule = schedules[in.next() % 5];
+
+    Scope sc;
+    std::string body;
+    block(in, sc, 0, "        ", body);
+
+    std::string prologue =
+        "int a[" + std::to_string(SIZE) + "];\n"
+        "int b[" + std::to_string(SIZE) + "];\n"
+        "float f[" + std::to_string(SIZE) + "];\n"
+        "float g[" + std::to_string(SIZE) + "];\n"
+        "int main() {\n"
+        "    int i;\n"
+        "    int s = 0;\n"
+        "    int p = 1;\n"
+        "    int lo = 1000;\n"
+        "    int hi = 0;\n"
+        "    float x = " + std::to_string(in.next() % 10) + ".5;\n"
+        "    for (i = 0; i < " + std::to_string(SIZE) + "; i = i + 1) {\n"
+        "        b[i] = i * " + std::to_string(in.next() % 50) + " - " + std::to_string(in.next() % 100) + ";\n"
+        "        g[i] = x;\n"
+        "        x = x * 1.5 - 2.25;\n"
+        "    }\n";
+    std::string epilogue =
+        "    }\n"
+        "    Print(i);\n"
+        "    Print(s);\n"
+        "    Print(p);\n"
+        "    Print(lo);\n"
+        "    Print(hi);\n"
+        "    for (i = 0; i < " + std::to_string(SIZE) + "; i = i + 1) {\n"
+        "        Print(a[i]);\n"
+        "        Print(f[i]);\n"
+        "    }\n"
+        "}\n";
+
+    // aceleasi linii in ambele programe, ca Print sa raporteze aceleasi numere de linie
+    std::string sequential = prologue + "    " + header + " {\n" + body + epilogue;
+    std::string parallel   = prologue + "    " + schedule + header +
+                             " reduce(+: s, *: p, min: lo, max: hi) {\n" + body + epilogue;
+
+    std::string seqOutput, parOutput;
+    bool seqOk  = compileAndRun(sequential.data(), sequential.size(), seqOutput);
+    bool seqCut = fuzzBudget < 0;
+    bool parOk  = compileAndRun(parallel.data(), parallel.size(), parOutput);
+
+    // interpretorul si kernelul numara nodurile evaluate diferit: langa limita
+    // doar unul dintre ele s-ar putea opri, deci rezultatul nu spune nimic
+    if (seqCut || fuzzBudget < 0)
+        return 0;
+
+    std::vector<std::string> expected = printedResults(seqOutput);
+    std::vector<std::string> got      = printedResults(parOutput);
+
+    if (seqOk != parOk || (seqOk && expected != got))
+    {
+        std::fprintf(stderr, "Differential mismatch for program:\n%s\nfor:          %s\nparallel for: %s\n",
+                     parallel.c_str(), seqOk ? joined(expected).c_str() : "<error>",
+                     parOk ? joined(got).c_str() : "<error>");
+        std::abort();
+    }
+    return 0;
+}
@@ -0,0 +1,17 @@
+// Fuzzing pentru parser + interpretor (libFuzzer / AFL++), vezi README.
+// Fiecare input e un program: se compileaza si se executa din memorie.
+// Erorile de compilare sunt rezultate normale; un crash, un raport ASan/UBSan,
+// un timeout sau depasirea limitei de memorie inseamna un bug.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+bool compileAndRun(const char* data, std::size_t size, std::string& output); // compiler.y
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size)
+{
+    std::string output;
+    compileAndRun(reinterpret_cast<const char*>(data), size, output);
+    return 0;
+}
@@ -0,0 +1,499 @@
+#pragma once
+
+#include <algorithm>      // std::max
+#include <chrono>         // std::chrono::steady_clock (durata pauzelor)
+#include <cstddef>        // std::size_t
+#include <cstdint>        // std::uint8_t, std::uint16_t, std::uint32_t, std::uint64_t, std::uintptr_t
+#include <cstring>        // std::memcpy
+#include <iomanip>        // std::setw
+#include <memory>         // std::unique_ptr
+#include <new>            // ::operator new / ::operator delete
+#include <ostream>        // std::ostream
+#include <vector>         // std::vector
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          HEAP CU COLECTOR DE GUNOI (NURSERY + GENERATIA VECHE)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Un obiect = antet + `refs` pointeri catre alte obiecte + `bytes` octeti de date.
+//  - alocarea se face prin incrementarea unui pointer in eden (nursery);
+//  - cand eden se umple, colectarea minora copiaza obiectele vii din eden si din
+//    survivor-ul curent in celalalt survivor. Cele care au supravietuit deja de
+//    TENURE_AGE ori (sau nu mai incap) se muta in generatia veche;
+//  - generatia veche nu se muta: fiecare obiect e alocat separat, iar colectarea
+//    completa (mark-sweep) porneste cand creste peste prag (de 2 ori cat era viu
+//    dupa colectarea completa anterioara). Obiectele prea mari pentru eden se
+//    aloca direct aici;
+//  - radacinile sunt handle-urile: sloturi intr-un tabel, cate unul pentru fiecare
+//    referinta tinuta din afara heap-ului (variabile, valori temporare etc.).
+//    Cand muta un obiect, colectorul actualizeaza slotul;
+//  - un obiect vechi care primeste un pointer catre unul tanar intra in remembered
+//    set (write barrier in setRef), ca si colectarea minora sa-l gaseasca.
+// O colectare poate porni la orice alocare, deci intre doua alocari pointerii la
+// obiecte se tin doar in handle-uri sau in alte obiecte. Un handle neeliberat (ex.
+// pe stiva unui task abandonat dupa o eroare) doar tine obiectul in viata.
+// Heap-ul e folosit de un singur fir.
+
+struct GcObject
+{
+    std::uint32_t bytes;   // datele de dupa pointeri
+    std::uint16_t refs;    // pointerii de la inceputul obiectului
+    std::uint8_t  flags;   // MARKED, FORWARDED, REMEMBERED + varsta
+    std::uint8_t  tag;     // la dispozitia utilizatorului (ex. tipul nodului)
+
+    GcObject** ref()
+    {
+        return reinterpret_cast<GcObject**>(this + 1);
+    }
+
+    char* data()
+    {
+        return reinterpret_cast<char*>(ref() + refs);
+    }
+};
+
+struct GcStats
+{
+    std::uint64_t allocatedBytes   = 0;
+    std::uint64_t allocatedObjects = 0;
+    std::uint64_t pretenuredBytes  = 0;   // alocati direct in generatia veche
+    std::uint64_t minorCount       = 0;
+    std::uint64_t fullCount        = 0;
+    std::uint64_t minorNs          = 0, maxMinorNs = 0;
+    std::uint64_t fullNs           = 0, maxFullNs  = 0;
+    std::uint64_t minorCollected   = 0;   // octeti eliberati din nursery
+    std::uint64_t fullCollected    = 0;   // octeti eliberati din generatia veche
+    std::uint64_t promotedBytes    = 0;
+    std::size_t   peakOldBytes     = 0;
+    std::size_t   peakHandles      = 0;
+};
+
+class GcHeap
+{
+public:
+    static constexpr std::size_t DEFAULT_NURSERY = 256 * 1024;
+    static constexpr std::size_t MIN_NURSERY     = 4 * 1024;
+    static constexpr std::size_t FULL_MIN        = 1024 * 1024;   // pragul minim pt. colectarea completa
+    static constexpr int         TENURE_AGE      = 2;
+    static constexpr std::size_t EVENT_LOG_MAX   = 4096;
+
+    GcHeap() = default;
+    GcHeap(const GcHeap&) = delete;
+    GcHeap& operator=(const GcHeap&) = delete;
+
+    // Nursery-ul: 3/4 eden, cate 1/8 pentru fiecare survivor. Obiectele tinere
+    // existente se muta intai in generatia veche.
+    void setNurserySize(std::size_t bytes)
+    {
+        bytes = std::max(roundUp(bytes), MIN_NURSERY);
+        if (bytes == nurserySize)
+            return;
+        if (block)
+            collect(true);
+        nurserySize = bytes;
+        block.reset();
+    }
+
+    std::size_t nurseryBytes() const
+    {
+        return nurserySize;
+    }
+
+    // Obiect nou, cu pointerii nuli. Poate porni o colectare.
+    GcObject* allocate(std::uint16_t refs, std::uint32_t bytes, std::uint8_t tag)
+    {
+        if (!block)
+            createNursery();
+
+        std::size_t size = objectSize(refs, bytes);
+        GcObject*   obj;
+        if (size > edenSize() / 4)
+        {
+            if (oldBytes + size > fullThreshold)
+                collect(true);
+            obj = allocateOld(size);
+            stats.pretenuredBytes += size;
+        }
+        else
+        {
+            if (edenTop + size > edenEnd)
+                collect(false);
+            obj = reinterpret_cast<GcObject*>(edenTop);
+            edenTop += size;
+        }
+
+        obj->bytes = bytes;
+        obj->refs  = refs;
+        obj->flags = 0;
+        obj->tag   = tag;
+        for (std::uint16_t i = 0; i < refs; i++)
+            obj->ref()[i] = nullptr;
+        stats.allocatedBytes += size;
+        stats.allocatedObjects++;
+        return obj;
+    }
+
+    // Scrierea unui pointer intr-un obiect (cu write barrier)
+    void setRef(GcObject* obj, int i, GcObject* value)
+    {
+        obj->ref()[i] = value;
+        if (value && isYoung(value) && !isYoung(obj) && !(obj->flags & REMEMBERED))
+        {
+            obj->flags |= REMEMBERED;
+            remembered.push_back(obj);
+        }
+    }
+
+    // ---- handle-uri (radacinile) ----
+
+    std::uint32_t newHandle(GcObject* obj)
+    {
+        std::uint32_t h;
+        if (freeHandles.empty())
+        {
+            h = static_cast<std::uint32_t>(handles.size());
+            handles.push_back(obj);
+        }
+        else
+        {
+            h = freeHandles.back();
+            freeHandles.pop_back();
+            handles[h] = obj;
+        }
+        stats.peakHandles = std::max(stats.peakHandles, handles.size() - freeHandles.size());
+        return h;
+    }
+
+    void releaseHandle(std::uint32_t h)
+    {
+        handles[h] = nullptr;
+        freeHandles.push_back(h);
+    }
+
+    GcObject* get(std::uint32_t h) const
+    {
+        return handles[h];
+    }
+
+    void set(std::uint32_t h, GcObject* obj)
+    {
+        handles[h] = obj;
+    }
+
+    // ---- colectarea ----
+
+    // Minora: doar nursery-ul. Completa: tot nursery-ul trece in generatia veche,
+    // apoi mark-sweep pe generatia veche.
+    void collect(bool full)
+    {
+        auto        start       = std::chrono::steady_clock::now();
+        std::size_t youngBefore = static_cast<std::size_t>(edenTop - edenStart) + survivorUsed;
+        std::size_t oldBefore   = oldBytes;
+
+        std::size_t promoted = evacuate(full);
+        std::size_t survived = survivorUsed;
+        stats.minorCollected += youngBefore - promoted - survived;
+        stats.promotedBytes  += promoted;
+
+        std::size_t swept = 0;
+        if (full)
+        {
+            swept         = markSweep();
+            fullThreshold = std::max(FULL_MIN, 2 * oldBytes);
+            stats.fullCollected += swept;
+        }
+
+        auto ns = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                      std::chrono::steady_clock::now() - start).count());
+        if (full)
+        {
+            stats.fullCount++;
+            stats.fullNs   += ns;
+            stats.maxFullNs = std::max(stats.maxFullNs, ns);
+        }
+        else
+        {
+            stats.minorCount++;
+            stats.minorNs   += ns;
+            stats.maxMinorNs = std::max(stats.maxMinorNs, ns);
+        }
+        if (events.size() < EVENT_LOG_MAX)
+            events.push_back({full, youngBefore, survived, promoted, oldBefore + promoted, oldBytes, ns});
+        else
+            eventsDropped++;
+
+        // generatia veche a crescut peste prag dupa o colectare minora
+        if (!full && oldBytes > fullThreshold)
+            collect(true);
+    }
+
+    const GcStats& statistics() const
+    {
+        return stats;
+    }
+
+    std::size_t oldGenerationBytes() const
+    {
+        return oldBytes;
+    }
+
+    std::size_t liveHandles() const
+    {
+        return handles.size() - freeHandles.size();
+    }
+
+    // Raportul pentru --gc-stats: totaluri, apoi fiecare colectare
+    void writeReport(std::ostream& out) const
+    {
+        auto us = [](std::uint64_t ns) { return ns / 1000; };
+
+        // singurul client e RtString: cifrele nu spun nimic despre restul memoriei
+        out << "String heap only: long strings and rope nodes. Objects, arrays, other values and\n"
+               "the interpreter's own memory are not allocated here and are not counted.\n\n";
+        out << "Nursery: " << nurserySize << " bytes (eden " << edenSize() << ", 2 x "
+            << survivorSize() << " survivor), tenure age " << TENURE_AGE << "\n";
+        out << "Allocated: " << stats.allocatedBytes << " bytes in " << stats.allocatedObjects
+            << " objects (" << stats.pretenuredBytes << " bytes directly in the old generation)\n";
+        out << "Minor collections: " << stats.minorCount << ", " << us(stats.minorNs) << " us total, "
+            << us(stats.maxMinorNs) << " us max\n";
+        out << "Full collections: " << stats.fullCount << ", " << us(stats.fullNs) << " us total, "
+            << us(stats.maxFullNs) << " us max\n";
+        out << "Collected: " << stats.minorCollected + stats.fullCollected << " bytes (nursery "
+            << stats.minorCollected << ", old generation " << stats.fullCollected << ")\n";
+        out << "Promoted: " << stats.promotedBytes << " bytes\n";
+        out << "Old generation: " << oldBytes << " bytes now, " << stats.peakOldBytes << " bytes peak\n";
+        out << "Handles: " << liveHandles() << " live, " << stats.peakHandles << " peak\n";
+
+        if (events.empty())
+            return;
+        out << "\n   #  kind   young before  survived  promoted  old before  old after  pause (us)\n";
+        for (std::size_t i = 0; i < events.size(); i++)
+        {
+            const Event& e = events[i];
+            out << std::setw(4) << i + 1 << "  " << (e.full ? "full " : "minor")
+                << std::setw(15) << e.youngBefore << std::setw(10) << e.survived
+                << std::setw(10) << e.promoted << std::setw(12) << e.oldBefore
+                << std::setw(11) << e.oldAfter << std::setw(12) << us(e.ns) << "\n";
+        }
+        if (eventsDropped)
+            out << "... " << eventsDropped << " more collections not listed\n";
+    }
+
+private:
+    static constexpr std::uint8_t MARKED     = 1;
+    static constexpr std::uint8_t FORWARDED  = 2;
+    static constexpr std::uint8_t REMEMBERED = 4;
+    static constexpr int          AGE_SHIFT  = 4;
+
+    struct Event
+    {
+        bool          full;
+        std::size_t   youngBefore, survived, promoted;
+        std::size_t   oldBefore, oldAfter;   // old before include si ce s-a promovat
+        std::uint64_t ns;
+    };
+
+    std::size_t             nurserySize = DEFAULT_NURSERY;
+    std::unique_ptr<char[]> block;                         // eden + 2 survivori
+    char*                   edenStart = nullptr;
+    char*                   edenTop   = nullptr;
+    char*                   edenEnd   = nullptr;
+    char*                   fromSpace = nullptr;           // survivor-ul cu obiectele vii
+    char*                   toSpace   = nullptr;
+    std::size_t             survivorUsed = 0;
+
+    std::vector<GcObject*>     old;                        // generatia veche
+    std::size_t                oldBytes      = 0;
+    std::size_t                fullThreshold = FULL_MIN;
+    std::vector<GcObject*>     remembered;
+    std::vector<GcObject*>     handles;
+    std::vector<std::uint32_t> freeHandles;
+    std::vector<GcObject*>     work;                       // obiecte copiate, de parcurs
+
+    GcStats            stats;
+    std::vector<Event> events;
+    std::uint64_t      eventsDropped = 0;
+
+    static std::size_t roundUp(std::size_t n)
+    {
+        return (n + 7) & ~static_cast<std::size_t>(7);
+    }
+
+    // Cel putin antetul + un pointer: acolo se scrie adresa noua la copiere
+    static std::size_t objectSize(std::uint16_t refs, std::uint32_t bytes)
+    {
+        return std::max(roundUp(sizeof(GcObject) + refs * sizeof(GcObject*) + bytes),
+                        sizeof(GcObject) + sizeof(GcObject*));
+    }
+
+    static std::size_t objectSize(const GcObject* obj)
+    {
+        return objectSize(obj->refs, obj->bytes);
+    }
+
+    std::size_t edenSize() const
+    {
+        return nurserySize - 2 * survivorSize();
+    }
+
+    std::size_t survivorSize() const
+    {
+        return roundUp(nurserySize / 8);
+    }
+
+    void createNursery()
+    {
+        block.reset(new char[nurserySize]);
+        edenStart = edenTop = block.get();
+        edenEnd   = edenStart + edenSize();
+        fromSpace = edenEnd;
+        toSpace   = fromSpace + survivorSize();
+        survivorUsed = 0;
+    }
+
+    bool isYoung(const GcObject* obj) const
+    {
+        auto p = reinterpret_cast<std::uintptr_t>(obj);
+        auto b = reinterpret_cast<std::uintptr_t>(block.get());
+        return block && p >= b && p < b + nurserySize;
+    }
+
+    GcObject* allocateOld(std::size_t size)
+    {
+        auto* obj = static_cast<GcObject*>(::operator new(size));
+        old.push_back(obj);
+        oldBytes += size;
+        stats.peakOldBytes = std::max(stats.peakOldBytes, oldBytes);
+        return obj;
+    }
+
+    static GcObject*& forwardee(GcObject* obj)
+    {
+        return obj->ref()[0];   // objectSize() lasa loc pentru el si cand refs == 0
+    }
+
+    // Copiaza un obiect tanar (o singura data) si intoarce adresa lui noua
+    GcObject* copy(GcObject* obj, bool tenureAll, std::size_t& toUsed, std::size_t& promoted)
+    {
+        if (!obj || !isYoung(obj))
+            return obj;
+        if (obj->flags & FORWARDED)
+            return forwardee(obj);
+
+        std::size_t size = objectSize(obj);
+        int         age  = (obj->flags >> AGE_SHIFT) + 1;
+        GcObject*   to;
+        if (!tenureAll && age < TENURE_AGE && toUsed + size <= survivorSize())
+        {
+            to = reinterpret_cast<GcObject*>(toSpace + toUsed);
+            toUsed += size;
+            std::memcpy(static_cast<void*>(to), obj, size);
+            to->flags = static_cast<std::uint8_t>(age << AGE_SHIFT);
+        }
+        else
+        {
+            to = allocateOld(size);
+            std::memcpy(static_cast<void*>(to), obj, size);
+            to->flags = 0;
+            promoted += size;
+        }
+        obj->flags |= FORWARDED;
+        forwardee(obj) = to;
+        work.push_back(to);
+        return to;
+    }
+
+    // Colectarea minora (Cheney, cu lista de lucru in loc de scanarea liniara,
+    // fiindca obiectele promovate nu stau unul dupa altul). Intoarce octetii promovati.
+    std::size_t evacuate(bool tenureAll)
+    {
+        std::size_t toUsed = 0, promoted = 0;
+        if (!block)
+            return 0;
+
+        for (GcObject*& root : handles)
+            root = copy(root, tenureAll, toUsed, promoted);
+
+        std::vector<GcObject*> oldRemembered;
+        oldRemembered.swap(remembered);
+        for (GcObject* obj : oldRemembered)
+        {
+            obj->flags &= static_cast<std::uint8_t>(~REMEMBERED);
+            work.push_back(obj);
+        }
+
+        while (!work.empty())
+        {
+            GcObject* obj = work.back();
+            work.pop_back();
+            bool pointsToYoung = false;
+            for (std::uint16_t i = 0; i < obj->refs; i++)
+            {
+                GcObject*& r = obj->ref()[i];
+                r = copy(r, tenureAll, toUsed, promoted);
+                pointsToYoung = pointsToYoung || (r && isYoung(r));
+            }
+            // un obiect vechi (promovat acum sau din remembered set) care pointeaza
+            // in survivor ramane in remembered set
+            if (pointsToYoung && !isYoung(obj) && !(obj->flags & REMEMBERED))
+            {
+                obj->flags |= REMEMBERED;
+                remembered.push_back(obj);
+            }
+        }
+
+        std::swap(fromSpace, toSpace);
+        survivorUsed = toUsed;
+        edenTop      = edenStart;
+        return promoted;
+    }
+
+    // Doar dupa evacuate(true): nursery-ul e gol. Intoarce octetii eliberati.
+    std::size_t markSweep()
+    {
+        for (GcObject* root : handles)
+            mark(root);
+
+        std::size_t freed = 0, kept = 0;
+        for (GcObject* obj : old)
+        {
+            if (obj->flags & MARKED)
+            {
+                obj->flags &= static_cast<std::uint8_t>(~MARKED);
+                old[kept++] = obj;
+            }
+            else
+            {
+                std::size_t size = objectSize(obj);
+                freed += size;
+                ::operator delete(obj);
+            }
+        }
+        old.resize(kept);
+        oldBytes -= freed;
+        return freed;
+    }
+
+    // Fara recursivitate: un rope lung are adancime mare
+    void mark(GcObject* root)
+    {
+        if (!root || (root->flags & MARKED))
+            return;
+        root->flags |= MARKED;
+        work.push_back(root);
+        while (!work.empty())
+        {
+            GcObject* obj = work.back();
+            work.pop_back();
+            for (std::uint16_t i = 0; i < obj->refs; i++)
+            {
+                GcObject* r = obj->ref()[i];
+                if (r && !(r->flags & MARKED))
+                {
+                    r->flags |= MARKED;
+                    work.push_back(r);
+                }
+            }
+        }
+    }
+};
@@ -0,0 +1,70 @@
+// Benchmark pentru lexer (fara parser): ./lexbench fisier [repetari]
+// Fisierul se copiaza de `repetari` ori intr-un buffer din memorie, apoi se
+// apeleaza yylex() pana la sfarsit; se afiseaza MB/s si token-uri/s.
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "compiler.hpp"      // internSymbol() si pool-ul de simboluri
+#include "compiler.tab.hpp"  // token-urile si YYSTYPE
+
+YYSTYPE yylval;              // in compilator il defineste parser-ul
+
+struct yy_buffer_state;
+yy_buffer_state* yy_scan_bytes(const char* bytes, int len);
+void yy_delete_buffer(yy_buffer_state* buffer);
+extern int yylex();
+extern int yylineno;
+
+int main(int argc, char** argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " file [repeat]\n";
+        return 1;
+    }
+
+    std::ifstream in(argv[1], std::ios::binary);
+    if (!in)
+    {
+        std::cerr << "Cannot open " << argv[1] << "\n";
+        return 1;
+    }
+    std::stringstream ss;
+    ss << in.rdbuf();
+    std::string chunk = ss.str() + "\n";
+
+    int repeat = (argc > 2) ? std::stoi(argv[2]) : 1000;
+    std::string input;
+    input.reserve(chunk.size() * repeat);
+    for (int i = 0; i < repeat; i++)
+        input += chunk;
+
+    // cea mai buna din cateva rulari, ca sa nu masuram incalzirea cache-urilor
+    double best = 1e30;
+    long   tokens = 0;
+    for (int run = 0; run < 5; run++)
+    {
+        yylineno = 1;
+        tokens   = 0;
+        yy_buffer_state* buffer = yy_scan_bytes(input.data(), static_cast<int>(input.size()));
+
+        auto start = std::chrono::steady_clock::now();
+        while (yylex() != 0)
+            tokens++;
+        auto end = std::chrono::steady_clock::now();
+
+        yy_delete_buffer(buffer);
+        best = std::min(best, std::chrono::duration<double>(end - start).count());
+    }
+
+    double mb = input.size() / (1024.0 * 1024.0);
+    std::cout << "input:  " << input.size() << " bytes, " << tokens << " tokens, "
+              << yylineno - 1 << " lines\n";
+    std::cout << "time:   " << best * 1000 << " ms (best of 5)\n";
+    std::cout << "speed:  " << mb / best << " MB/s, " << tokens / best / 1e6 << " Mtokens/s\n";
+    return 0;
+}
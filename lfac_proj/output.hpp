@@ -0,0 +1,184 @@
+#pragma once
+
+#include <cerrno>         // errno, EINTR
+#include <charconv>       // std::to_chars
+#include <ostream>        // std::ostream
+#include <streambuf>      // std::streambuf
+#include <string>         // std::string
+#include <vector>         // std::vector
+
+#include <fcntl.h>        // open
+#include <unistd.h>       // write, close, STDOUT_FILENO
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          IESIREA PROGRAMULUI (Print / TypeOf)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Textul se aduna intr-un buffer mare si se scrie cu write(2) doar cand bufferul
+// se umple, la flush explicit si la iesire (destructorul ruleaza si la std::exit).
+// Implicit bufferul ia locul celui din std::cout, deci liniile [DEBUG] si cele
+// din Print raman in ordine; std::cerr e legat de std::cout, asa ca un mesaj de
+// eroare goleste intai ce s-a scris pana atunci.
+
+class FdOutputBuffer : public std::streambuf
+{
+public:
+    static constexpr std::size_t CAPACITY = 1 << 16;
+
+    FdOutputBuffer() : buffer(CAPACITY)
+    {
+        setp(buffer.data(), buffer.data() + buffer.size());
+    }
+
+    ~FdOutputBuffer() override
+    {
+        sync();
+        if (bound)
+            bound->rdbuf(previous);
+        if (owned)
+            ::close(fd);
+    }
+
+    FdOutputBuffer(const FdOutputBuffer&) = delete;
+    FdOutputBuffer& operator=(const FdOutputBuffer&) = delete;
+
+    void attach(int target)
+    {
+        sync();
+        fd = target;
+    }
+
+    bool open(const std::string& path)
+    {
+        int target = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (target < 0)
+            return false;
+        attach(target);
+        owned = true;
+        return true;
+    }
+
+    // os scrie de acum in acest buffer; legatura se desface la distrugere
+    void bind(std::ostream& os)
+    {
+        previous = os.rdbuf(this);
+        bound    = &os;
+    }
+
+    bool failed() const
+    {
+        return error;
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!drain())
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(ch, traits_type::eof()))
+        {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+
+    std::streamsize xsputn(const char* s, std::streamsize n) override
+    {
+        if (n <= epptr() - pptr())
+        {
+            traits_type::copy(pptr(), s, static_cast<std::size_t>(n));
+            pbump(static_cast<int>(n));
+            return n;
+        }
+        // textele mari nu mai trec prin buffer
+        if (!drain() || !writeAll(s, static_cast<std::size_t>(n)))
+            return 0;
+        return n;
+    }
+
+    int sync() override
+    {
+        return drain() ? 0 : -1;
+    }
+
+private:
+    bool writeAll(const char* s, std::size_t n)
+    {
+        while (n > 0 && !error)
+        {
+            ssize_t written = ::write(fd, s, n);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                error = true;
+                break;
+            }
+            s += written;
+            n -= static_cast<std::size_t>(written);
+        }
+        return !error;
+    }
+
+    bool drain()
+    {
+        bool ok = writeAll(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+        setp(buffer.data(), buffer.data() + buffer.size());
+        return ok;
+    }
+
+    std::vector<char> buffer;
+    int               fd       = STDOUT_FILENO;
+    bool              owned    = false;
+    bool              error    = false;
+    std::ostream*     bound    = nullptr;
+    std::streambuf*   previous = nullptr;
+};
+
+// Unde si cum scriu Print / TypeOf (optiunile --raw-output, --output, --output-fd)
+struct ProgramOutput
+{
+    bool           raw = false;       // doar valoarea, fara "Function Print was called ..."
+    FdOutputBuffer buffer;
+    std::ostream   redirected{nullptr};
+    std::ostream*  stream = &std::cout;
+
+    // std::cout (deci si [DEBUG]) prin buffer, spre stdout
+    void bufferStdout()
+    {
+        buffer.bind(std::cout);
+    }
+
+    bool toFile(const std::string& path)
+    {
+        if (!buffer.open(path))
+            return false;
+        redirected.rdbuf(&buffer);
+        stream = &redirected;
+        return true;
+    }
+
+    void toFd(int fd)
+    {
+        buffer.attach(fd);
+        redirected.rdbuf(&buffer);
+        stream = &redirected;
+    }
+
+    // Goleste bufferul; false daca vreo scriere a esuat
+    bool finish()
+    {
+        stream->flush();
+        return !buffer.failed() && !stream->bad();
+    }
+};
+
+// Numerele se scriu direct din buffer-ul lui std::to_chars, fara std::string temporar
+template <typename T>
+void writeNumber(std::ostream& os, T value)
+{
+    char digits[24];
+    auto res = std::to_chars(digits, digits + sizeof(digits), value);
+    os.write(digits, res.ptr - digits);
+}
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>            // std::min
+#include <atomic>               // std::atomic
+#include <condition_variable>   // std::condition_variable
+#include <functional>           // std::function
+#include <mutex>                // std::mutex
+#include <thread>               // std::thread
+#include <vector>               // std::vector
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          IMPARTIREA ITERATIILOR PE FIRE (parallel for)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Iteratiile 0 .. count-1 se impart intre `threads` fire; firul 0 e cel curent.
+//  - static, chunk == 0: fiecare fir primeste un singur bloc continuu;
+//  - static, chunk  > 0: bucati de chunk iteratii, date pe rand firelor (0, 1, ..);
+//  - dynamic: fiecare fir ia urmatoarea bucata libera (chunk implicit 1).
+// work(fir, inceput, sfarsit) ruleaza o bucata, cu iteratiile in ordine crescatoare;
+// run() se intoarce dupa ce s-au terminat toate firele.
+// Firele 1, 2, .. sunt ale unui WorkerPool comun: pornite la prima bucla care le cere
+// si refolosite de toate executiile urmatoare, pana la iesirea din program.
+
+class WorkerPool
+{
+public:
+    using Job = std::function<void(int thread)>;
+
+    WorkerPool() = default;
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& th : threads)
+            th.join();
+    }
+
+    // job(0) pe firul curent, job(1) .. job(used - 1) pe firele pool-ului; nu e reentrant
+    void run(int used, const Job& job)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            while (static_cast<int>(threads.size()) < used - 1)
+            {
+                int t = static_cast<int>(threads.size()) + 1;
+                threads.emplace_back([this, t] { loop(t); });
+            }
+            current = &job;
+            active  = used;
+            pending = used - 1;
+            generation++;
+        }
+        wake.notify_all();
+        job(0);
+
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this] { return pending == 0; });
+        current = nullptr;
+    }
+
+private:
+    std::mutex               mutex;
+    std::condition_variable  wake, done;
+    std::vector<std::thread> threads;
+    const Job*               current    = nullptr;
+    int                      active     = 0;   // firele executiei curente, cu firul 0
+    int                      pending    = 0;   // firele pool-ului care n-au terminat
+    unsigned long long       generation = 0;   // creste la fiecare run()
+    bool                     stopping   = false;
+
+    // Firul t asteapta executiile; ia parte doar la cele care au cel putin t + 1 fire
+    void loop(int t)
+    {
+        unsigned long long seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping)
+                return;
+            seen = generation;
+            if (t >= active)
+                continue;
+            const Job* job = current;
+            lock.unlock();
+            (*job)(t);
+            lock.lock();
+            if (--pending == 0)
+                done.notify_one();
+        }
+    }
+};
+
+struct ParallelRange
+{
+    long long count   = 0;
+    int       threads = 1;
+    bool      dynamic = false;
+    long long chunk   = 0;
+
+    using Work = std::function<void(int thread, long long begin, long long end)>;
+
+    // Firele efectiv folosite: nu mai multe decat iteratiile
+    int threadCount() const
+    {
+        return static_cast<int>(std::min<long long>(threads < 1 ? 1 : threads, count < 1 ? 1 : count));
+    }
+
+    void run(const Work& work) const
+    {
+        int used = threadCount();
+        std::atomic<long long> next{0};
+
+        auto worker = [&](int t)
+        {
+            if (dynamic)
+            {
+                long long size = chunk > 0 ? chunk : 1;
+                for (long long begin; (begin = next.fetch_add(size, std::memory_order_relaxed)) < count;)
+                    work(t, begin, std::min(begin + size, count));
+            }
+            else if (chunk > 0)
+            {
+                for (long long begin = t * chunk; begin < count; begin += used * chunk)
+                    work(t, begin, std::min(begin + chunk, count));
+            }
+            else
+            {
+                long long block = count / used, extra = count % used;
+                long long begin = t * block + std::min<long long>(t, extra);
+                work(t, begin, begin + block + (t < extra ? 1 : 0));
+            }
+        };
+
+        workers.run(used, worker);
+    }
+
+private:
+    static inline WorkerPool workers;
+};
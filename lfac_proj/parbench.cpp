@@ -0,0 +1,71 @@
+// Benchmark pentru parallel for: ./parbench [compilator] [program] [fire]
+// Ruleaza `compilator --threads=t --output=/dev/null program` pentru t = 1 .. fire
+// si citeste durata buclelor din liniile "[DEBUG] parallel for ... in N us";
+// afiseaza cea mai buna din 5 rulari si accelerarea fata de un singur fir.
+
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Suma duratelor tuturor buclelor paralele dintr-o rulare (-1 daca n-a rulat niciuna)
+static long long runOnce(const std::string& command)
+{
+    FILE* pipe = popen(command.c_str(), "r");
+    if (!pipe)
+        return -1;
+
+    long long total = -1;
+    char      line[4096];
+    while (std::fgets(line, sizeof line, pipe))
+    {
+        std::string text = line;
+        if (text.rfind("[DEBUG] parallel for at line ", 0) != 0)
+            continue;
+        size_t in = text.rfind(" in ");
+        if (in == std::string::npos)
+            continue;
+        total = (total < 0 ? 0 : total) + std::stoll(text.substr(in + 4));
+    }
+    return pclose(pipe) == 0 ? total : -1;
+}
+
+int main(int argc, char** argv)
+{
+    std::string compiler = argc > 1 ? argv[1] : "./compiler";
+    std::string program  = argc > 2 ? argv[2] : "parbench.txt";
+    int         threads  = argc > 3 ? std::stoi(argv[3]) : static_cast<int>(std::thread::hardware_concurrency());
+    if (threads < 1)
+        threads = 1;
+
+    std::cout << "cores:  " << std::thread::hardware_concurrency() << "\n";
+    std::cout << "threads     time (ms)   speedup\n";
+
+    double base = 0;
+    for (int t = 1; t <= threads; t++)
+    {
+        std::string command = compiler + " --threads=" + std::to_string(t) + " --output=/dev/null " + program + " 2>/dev/null";
+
+        // cea mai buna din cateva rulari, ca sa nu masuram pornirea firelor la rece
+        long long best = -1;
+        for (int run = 0; run < 5; run++)
+        {
+            long long micros = runOnce(command);
+            if (micros < 0)
+            {
+                std::cerr << "Failed: " << command << "\n";
+                return 1;
+            }
+            if (best < 0 || micros < best)
+                best = micros;
+        }
+
+        double ms = best / 1000.0;
+        if (t == 1)
+            base = ms;
+        std::cout << std::setw(7) << t << std::setw(14) << std::fixed << std::setprecision(1) << ms
+                  << std::setw(9) << std::setprecision(2) << (ms > 0 ? base / ms : 0) << "x\n";
+    }
+    return 0;
+}
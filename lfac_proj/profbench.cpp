@@ -0,0 +1,57 @@
+// Benchmark pentru --profile: ./profbench [compilator] [program] [rulari]
+// Ruleaza `compilator --output=/dev/null program` cu si fara --profile, alternativ,
+// masoara durata intregului proces si afiseaza cea mai buna rulare din fiecare mod
+// si costul profilarii (tinta: sub 10%).
+
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+// Durata unei rulari in ms (-1 daca programul a esuat)
+static double runOnce(const std::string& command)
+{
+    auto start = std::chrono::steady_clock::now();
+    int  rc    = std::system(command.c_str());
+    auto end   = std::chrono::steady_clock::now();
+    if (rc != 0)
+        return -1;
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char** argv)
+{
+    std::string compiler = argc > 1 ? argv[1] : "./compiler";
+    std::string program  = argc > 2 ? argv[2] : "profbench.txt";
+    int         runs     = argc > 3 ? std::atoi(argv[3]) : 5;
+    if (runs < 1)
+        runs = 1;
+
+    // liniile [DEBUG] merg tot pe stdout: le aruncam, dar le formatam in ambele moduri
+    std::string plain    = compiler + " --output=/dev/null " + program + " >/dev/null 2>&1";
+    std::string profiled = compiler + " --profile --output=/dev/null " + program + " >/dev/null 2>&1";
+
+    // rularile alternate, ca incalzirea cache-urilor sa nu favorizeze un mod
+    double bestPlain = -1, bestProfiled = -1;
+    for (int run = 0; run < runs; run++)
+    {
+        double a = runOnce(plain);
+        double b = runOnce(profiled);
+        if (a < 0 || b < 0)
+        {
+            std::cerr << "Failed: " << (a < 0 ? plain : profiled) << "\n";
+            return 1;
+        }
+        if (bestPlain < 0 || a < bestPlain)
+            bestPlain = a;
+        if (bestProfiled < 0 || b < bestProfiled)
+            bestProfiled = b;
+    }
+
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "without --profile: " << std::setw(9) << bestPlain << " ms\n";
+    std::cout << "with --profile:    " << std::setw(9) << bestProfiled << " ms\n";
+    std::cout << "overhead:          " << std::setw(9) << (bestProfiled / bestPlain - 1) * 100 << " %\n";
+    return 0;
+}
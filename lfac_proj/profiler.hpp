@@ -0,0 +1,207 @@
+#pragma once
+
+#include <algorithm>      // std::sort
+#include <chrono>         // std::chrono::steady_clock
+#include <cstdint>        // std::uint64_t
+#include <iomanip>        // std::setw, std::setprecision
+#include <ostream>        // std::ostream
+#include <string>         // std::string
+#include <unordered_map>  // std::unordered_map
+#include <vector>         // std::vector
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          PROFILER PENTRU PROGRAMELE UTILIZATORULUI (--profile)
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Interpretorul deschide un cadru pentru fiecare instructiune executata si
+// pentru fiecare apel de functie. La inchidere, timpul cadrului se imparte in:
+//  - timp propriu al liniei (fara instructiunile imbricate si fara apeluri);
+//  - timp inclusiv / exclusiv al functiei (exclusiv = fara functiile apelate);
+//  - timp pe stiva de apeluri, scris in format "collapsed" (flamegraph.pl).
+// Cand profiler-ul e oprit, interpretorul nu apeleaza nimic de aici.
+
+struct Profiler
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct LineStats
+    {
+        std::uint64_t count  = 0;  // instructiuni executate pe linie
+        std::uint64_t selfNs = 0;
+    };
+
+    struct FuncStats
+    {
+        std::string   name;
+        std::uint64_t calls       = 0;
+        std::uint64_t inclusiveNs = 0;
+        std::uint64_t exclusiveNs = 0;
+        int           active      = 0; // apeluri in curs (recursivitate)
+    };
+
+    struct Frame
+    {
+        Clock::time_point start;
+        std::uint64_t childNs  = 0;  // cadre imbricate (instructiuni + apeluri)
+        std::uint64_t calleeNs = 0;  // pt. functii: timp in functiile apelate
+        int           line     = 0;
+        int           function = -1; // >= 0 => cadru de functie
+        std::size_t   parentFn = 0;  // indexul cadrului functiei apelante
+        std::size_t   stackLen = 0;  // lungimea lui stack inainte de apel
+    };
+
+    bool enabled = false;
+
+    std::vector<LineStats> lines;      // indexat dupa numarul liniei
+    std::vector<FuncStats> functions;  // indexat dupa id-ul dat de interpretor
+    std::unordered_map<std::string, std::uint64_t> folded; // "main;f;g" -> ns exclusiv
+    std::vector<Frame> frames;
+    std::string        stack;          // stiva curenta, "main;f;g"
+    std::size_t        currentFn = 0;  // indexul cadrului functiei curente
+    std::uint64_t      statements = 0;
+
+    void enterStatement(int line)
+    {
+        Frame f;
+        f.line     = line;
+        f.parentFn = currentFn;
+        frames.push_back(f);
+        frames.back().start = Clock::now();
+    }
+
+    void leaveStatement()
+    {
+        auto end = Clock::now();
+        Frame f = frames.back();
+        frames.pop_back();
+        std::uint64_t total = elapsed(f.start, end);
+
+        if (static_cast<std::size_t>(f.line) >= lines.size())
+            lines.resize(f.line + 1);
+        lines[f.line].count++;
+        lines[f.line].selfNs += total - f.childNs;
+        statements++;
+
+        if (!frames.empty())
+            frames.back().childNs += total;
+    }
+
+    // Numele afisat in raport (ex: "numere::suma"), dat o data inainte de executie
+    void nameFunction(int id, const std::string& name)
+    {
+        if (static_cast<std::size_t>(id) >= functions.size())
+            functions.resize(id + 1);
+        functions[id].name = name;
+    }
+
+    void enterFunction(int id)
+    {
+        FuncStats& fs = functions[id];
+        fs.calls++;
+        fs.active++;
+
+        Frame f;
+        f.function = id;
+        f.parentFn = currentFn;
+        f.stackLen = stack.size();
+        if (!stack.empty())
+            stack += ';';
+        stack += fs.name;
+
+        frames.push_back(f);
+        currentFn = frames.size() - 1;
+        frames.back().start = Clock::now();
+    }
+
+    void leaveFunction()
+    {
+        auto end = Clock::now();
+        Frame f = frames.back();
+        frames.pop_back();
+        std::uint64_t total = elapsed(f.start, end);
+        std::uint64_t self  = total - f.calleeNs;
+
+        FuncStats& fs = functions[f.function];
+        fs.active--;
+        if (fs.active == 0)              // la recursivitate numaram o singura data
+            fs.inclusiveNs += total;
+        fs.exclusiveNs += self;
+        folded[stack] += self;
+
+        stack.resize(f.stackLen);
+        currentFn = f.parentFn;
+        if (!frames.empty())
+        {
+            frames.back().childNs += total;
+            frames[currentFn].calleeNs += total;
+        }
+    }
+
+    // Raportul "flat": functii, apoi linii, sortate dupa timp
+    void writeReport(std::ostream& os) const
+    {
+        std::uint64_t totalNs = 0;
+        for (const auto& fs : functions)
+            totalNs += fs.exclusiveNs;
+
+        os << std::fixed << std::setprecision(3);
+        os << "Flat profile: " << ms(totalNs) << " ms, " << statements << " statements executed\n\n";
+
+        std::vector<const FuncStats*> fns;
+        for (const auto& fs : functions)
+            if (fs.calls)
+                fns.push_back(&fs);
+        std::sort(fns.begin(), fns.end(), [](const FuncStats* a, const FuncStats* b)
+                  { return a->exclusiveNs > b->exclusiveNs; });
+
+        os << "Per function:\n";
+        os << std::setw(10) << "calls" << std::setw(14) << "incl (ms)" << std::setw(14) << "excl (ms)"
+           << std::setw(9) << "excl %" << "  name\n";
+        for (const FuncStats* fs : fns)
+        {
+            os << std::setw(10) << fs->calls << std::setw(14) << ms(fs->inclusiveNs)
+               << std::setw(14) << ms(fs->exclusiveNs) << std::setw(8) << percent(fs->exclusiveNs, totalNs)
+               << "%  " << fs->name << "\n";
+        }
+
+        std::vector<int> lineNos;
+        for (std::size_t l = 0; l < lines.size(); l++)
+            if (lines[l].count)
+                lineNos.push_back(static_cast<int>(l));
+        std::sort(lineNos.begin(), lineNos.end(), [this](int a, int b)
+                  { return lines[a].selfNs > lines[b].selfNs; });
+
+        os << "\nPer line:\n";
+        os << std::setw(10) << "line" << std::setw(14) << "count" << std::setw(14) << "self (ms)"
+           << std::setw(9) << "self %" << "\n";
+        for (int l : lineNos)
+        {
+            os << std::setw(10) << l << std::setw(14) << lines[l].count
+               << std::setw(14) << ms(lines[l].selfNs) << std::setw(8) << percent(lines[l].selfNs, totalNs)
+               << "%\n";
+        }
+    }
+
+    // Format "collapsed": "main;f;g <microsecunde>", un rand pe stiva
+    void writeFolded(std::ostream& os) const
+    {
+        for (const auto& entry : folded)
+            os << entry.first << " " << entry.second / 1000 << "\n";
+    }
+
+private:
+    static std::uint64_t elapsed(Clock::time_point a, Clock::time_point b)
+    {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(b - a).count());
+    }
+
+    static double ms(std::uint64_t ns)
+    {
+        return ns / 1e6;
+    }
+
+    static double percent(std::uint64_t part, std::uint64_t total)
+    {
+        return total ? 100.0 * part / total : 0.0;
+    }
+};
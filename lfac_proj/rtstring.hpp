@@ -0,0 +1,299 @@
+#pragma once
+
+#include <cstddef>      // std::size_t
+#include <cstdint>      // std::uint32_t
+#include <cstring>      // std::memcpy
+#include <ostream>      // std::ostream
+#include <string>       // std::string
+#include <string_view>  // std::string_view
+#include <utility>      // std::swap
+#include <vector>       // stiva pentru parcurgeri iterative
+
+#include "gc.hpp"       // GcHeap: nodurile sirurilor lungi
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          TIPUL RUNTIME PENTRU VALORILE `string` DIN LIMBAJ
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// - sirurile scurte (<= INLINE_MAX) stau direct in obiect, fara alocare;
+// - sirurile lungi sunt noduri in heap-ul cu colector (gc.hpp); un RtString
+//   tine un handle catre nod, deci o copie (ex. ResultAST intors din
+//   evaluateTree) costa doar un slot nou, iar nodul se elibereaza cand nu mai
+//   ajunge la el niciun handle;
+// - `+` construieste un nod de concatenare (rope) in O(1); textul complet se
+//   construieste o singura data, la primul str(), si ramane in cache.
+
+class RtString
+{
+public:
+    static constexpr std::size_t INLINE_MAX = 15;
+    static constexpr std::size_t CHUNK_MAX  = 64;  // frunzele mici se lipesc pana la atat
+
+    // Nu se distruge niciodata: std::exit (la o eroare) poate rula pe stiva unui task
+    static inline GcHeap& heap = *new GcHeap();
+
+    RtString() = default;
+    RtString(const char* text) : RtString(std::string_view(text)) {}
+    RtString(const std::string& text) : RtString(std::string_view(text)) {}
+    RtString(std::string_view text)
+    {
+        if (text.size() <= INLINE_MAX)
+            setInline(text.data(), text.size());
+        else
+            handle = heap.newHandle(newLeaf(text));
+    }
+
+    RtString(const RtString& other) : inlineSize(other.inlineSize)
+    {
+        std::memcpy(inlineData, other.inlineData, INLINE_MAX);
+        if (other.handle != NO_HANDLE)
+            handle = heap.newHandle(heap.get(other.handle));
+    }
+
+    RtString(RtString&& other) noexcept : handle(other.handle), inlineSize(other.inlineSize)
+    {
+        std::memcpy(inlineData, other.inlineData, INLINE_MAX);
+        other.handle     = NO_HANDLE;
+        other.inlineSize = 0;
+    }
+
+    RtString& operator=(const RtString& other)
+    {
+        if (this != &other)
+        {
+            RtString copy(other);
+            swap(copy);
+        }
+        return *this;
+    }
+
+    RtString& operator=(RtString&& other) noexcept
+    {
+        RtString moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~RtString()
+    {
+        if (handle != NO_HANDLE)
+            heap.releaseHandle(handle);
+    }
+
+    std::size_t size() const
+    {
+        GcObject* n = node();
+        return n ? length(n) : inlineSize;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    // Textul complet (aplatizeaza rope-ul, o singura data)
+    std::string str() const
+    {
+        if (handle == NO_HANDLE)
+            return std::string(inlineData, inlineSize);
+        GcObject* leaf = flatLeaf();
+        return std::string(leaf->data(), leaf->bytes);
+    }
+
+    friend RtString operator+(const RtString& a, const RtString& b)
+    {
+        if (a.empty()) return b;
+        if (b.empty()) return a;
+
+        std::size_t total = a.size() + b.size();
+        if (total <= INLINE_MAX)
+        {
+            RtString res;
+            res.inlineSize = static_cast<unsigned char>(total);
+            a.copyTo(res.inlineData);
+            b.copyTo(res.inlineData + a.size());
+            return res;
+        }
+
+        // bucata mica lipita la o frunza mica: o singura frunza noua
+        if (total <= CHUNK_MAX && a.isLeaf() && b.isLeaf())
+            return RtString(a.leafText().append(b.leafText()));
+
+        // (x + frunza mica) + bucata mica => x + frunza lipita, ca rope-ul sa nu creasca
+        // cu un nod pentru fiecare caracter adaugat intr-o bucla
+        GcObject* an = a.node();
+        if (an && an->tag == CONCAT && an->ref()[LEFT] && b.isLeaf() && b.size() < CHUNK_MAX)
+        {
+            GcObject* right = leafOf(an->ref()[RIGHT]);
+            if (right && right->bytes + b.size() <= CHUNK_MAX)
+            {
+                std::string text(right->data(), right->bytes);
+                RtString    left = wrap(an->ref()[LEFT]);   // inainte de orice alocare
+                return concat(left, heapLeaf(text + b.leafText()));
+            }
+        }
+
+        return concat(a.toNode(), b.toNode());
+    }
+
+    friend bool operator==(const RtString& a, const RtString& b)
+    {
+        return a.size() == b.size() && a.str() == b.str();
+    }
+
+    friend bool operator!=(const RtString& a, const RtString& b)
+    {
+        return !(a == b);
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, const RtString& s)
+    {
+        return os << s.str();
+    }
+
+private:
+    // Nodurile din heap: frunza (textul in date) sau concatenare (left, right si,
+    // dupa aplatizare, flat = frunza cu tot textul; lungimea in date)
+    static constexpr std::uint8_t  LEAF   = 0;
+    static constexpr std::uint8_t  CONCAT = 1;
+    static constexpr int           LEFT = 0, RIGHT = 1, FLAT = 2;
+    static constexpr std::uint32_t NO_HANDLE = ~0u;
+
+    std::uint32_t handle = NO_HANDLE;     // pt. sirurile lungi
+    char          inlineData[INLINE_MAX] = {};
+    unsigned char inlineSize = 0;
+
+    GcObject* node() const
+    {
+        return handle == NO_HANDLE ? nullptr : heap.get(handle);
+    }
+
+    void swap(RtString& other) noexcept
+    {
+        std::swap(handle, other.handle);
+        std::swap(inlineData, other.inlineData);
+        std::swap(inlineSize, other.inlineSize);
+    }
+
+    void setInline(const char* text, std::size_t len)
+    {
+        std::memcpy(inlineData, text, len);
+        inlineSize = static_cast<unsigned char>(len);
+    }
+
+    static std::size_t length(GcObject* n)
+    {
+        if (n->tag == LEAF)
+            return n->bytes;
+        std::size_t len;
+        std::memcpy(&len, n->data(), sizeof len);
+        return len;
+    }
+
+    // Frunza cu textul nodului, daca exista deja (nullptr pt. o concatenare neaplatizata)
+    static GcObject* leafOf(GcObject* n)
+    {
+        return n->tag == LEAF ? n : n->ref()[FLAT];
+    }
+
+    // `text` nu are voie sa fie in heap: alocarea poate muta obiectele
+    static GcObject* newLeaf(std::string_view text)
+    {
+        GcObject* leaf = heap.allocate(0, static_cast<std::uint32_t>(text.size()), LEAF);
+        std::memcpy(leaf->data(), text.data(), text.size());
+        return leaf;
+    }
+
+    static RtString wrap(GcObject* n)
+    {
+        RtString res;
+        res.handle = heap.newHandle(n);
+        return res;
+    }
+
+    // Frunza in heap chiar si pentru un text scurt (copil de concatenare)
+    static RtString heapLeaf(std::string_view text)
+    {
+        return wrap(newLeaf(text));
+    }
+
+    // l si r au noduri in heap; handle-urile lor raman valide peste colectare
+    static RtString concat(const RtString& l, const RtString& r)
+    {
+        std::size_t len = l.size() + r.size();
+        GcObject*   n   = heap.allocate(3, sizeof len, CONCAT);
+        std::memcpy(n->data(), &len, sizeof len);
+        heap.setRef(n, LEFT, l.node());
+        heap.setRef(n, RIGHT, r.node());
+        return wrap(n);
+    }
+
+    bool isLeaf() const
+    {
+        GcObject* n = node();
+        return !n || leafOf(n);
+    }
+
+    // Doar pentru isLeaf()
+    std::string leafText() const
+    {
+        GcObject* n = node();
+        if (!n)
+            return std::string(inlineData, inlineSize);
+        GcObject* leaf = leafOf(n);
+        return std::string(leaf->data(), leaf->bytes);
+    }
+
+    void copyTo(char* out) const
+    {
+        if (handle != NO_HANDLE)
+        {
+            GcObject* leaf = flatLeaf();
+            std::memcpy(out, leaf->data(), leaf->bytes);
+        }
+        else
+        {
+            std::memcpy(out, inlineData, inlineSize);
+        }
+    }
+
+    RtString toNode() const
+    {
+        if (handle != NO_HANDLE)
+            return *this;
+        return heapLeaf(std::string_view(inlineData, inlineSize));
+    }
+
+    // Parcurgere in ordine, fara recursivitate. Rezultatul ramane in nod (flat),
+    // copiii nu mai sunt tinuti in viata, iar handle-ul trece direct pe frunza.
+    GcObject* flatLeaf() const
+    {
+        GcObject* root = node();
+        if (GcObject* leaf = leafOf(root))
+            return leaf;
+
+        std::string out;
+        out.reserve(length(root));
+        std::vector<GcObject*> stack{root};
+        while (!stack.empty())
+        {
+            GcObject* n = stack.back();
+            stack.pop_back();
+            if (GcObject* leaf = leafOf(n))
+            {
+                out.append(leaf->data(), leaf->bytes);
+                continue;
+            }
+            stack.push_back(n->ref()[RIGHT]);
+            stack.push_back(n->ref()[LEFT]);
+        }
+
+        GcObject* leaf = newLeaf(out);
+        root = node();   // alocarea poate sa fi mutat nodul
+        heap.setRef(root, FLAT, leaf);
+        heap.setRef(root, LEFT, nullptr);
+        heap.setRef(root, RIGHT, nullptr);
+        heap.set(handle, leaf);
+        return leaf;
+    }
+};
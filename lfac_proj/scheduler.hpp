@@ -0,0 +1,300 @@
+#pragma once
+
+#include <cstddef>        // std::size_t
+#include <deque>          // std::deque (coada task-urilor gata de rulare)
+#include <exception>      // std::exception_ptr
+#include <functional>     // std::function
+#include <memory>         // std::unique_ptr
+#include <new>            // std::bad_alloc
+#include <vector>         // std::vector
+
+#include <sys/mman.h>     // mmap, mprotect, munmap (stivele task-urilor)
+#include <ucontext.h>     // getcontext, makecontext, swapcontext
+#include <unistd.h>       // sysconf(_SC_PAGESIZE)
+
+// Sub AddressSanitizer fiecare comutare de stiva trebuie anuntata, altfel o exceptie
+// aruncata pe stiva unui task e raportata gresit (stack-buffer-overflow)
+#if defined(__SANITIZE_ADDRESS__)
+#define LFAC_ASAN_FIBERS 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define LFAC_ASAN_FIBERS 1
+#endif
+#endif
+#ifdef LFAC_ASAN_FIBERS
+#include <sanitizer/common_interface_defs.h>
+#endif
+
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//          TASK-URI COOPERATIVE (spawn) PE CORUTINE CU STIVA
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Fiecare task are stiva lui (ucontext), deci se poate opri oriunde in
+// interpretor, chiar si in mijlocul unei expresii sau al unui apel imbricat.
+// Planificatorul ruleaza task-urile pe rand, pe firul curent: un task ruleaza
+// pana se blocheaza (block), iar wake() il pune inapoi in coada. Interpretorul
+// salveaza / reface starea lui prin onSuspend / onResume.
+// Cand coada ramane goala, run() se termina; task-urile inca blocate inseamna
+// ca toate asteapta unul dupa altul (deadlock). Un task terminat isi elibereaza
+// stiva si contextul, iar id-ul lui se refoloseste la urmatorul spawn.
+
+// Stiva unui task: memorie mapata (paginile se aloca doar cand sunt atinse), cu o
+// pagina de garda PROT_NONE sub ea. Stiva creste in jos, deci o depasire se opreste
+// cu SIGSEGV pe garda, in loc sa scrie peste alta memorie.
+class TaskStack
+{
+public:
+    explicit TaskStack(std::size_t size) : usable(size), guard(static_cast<std::size_t>(sysconf(_SC_PAGESIZE)))
+    {
+        void* mem = mmap(nullptr, guard + usable, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (mem == MAP_FAILED)
+            throw std::bad_alloc();
+        base = static_cast<char*>(mem);
+        if (mprotect(base, guard, PROT_NONE) != 0)
+        {
+            munmap(base, guard + usable);
+            throw std::bad_alloc();
+        }
+    }
+
+    TaskStack(const TaskStack&) = delete;
+    TaskStack& operator=(const TaskStack&) = delete;
+
+    ~TaskStack()
+    {
+        munmap(base, guard + usable);
+    }
+
+    // Cel mai mic octet folosibil (imediat deasupra garzii)
+    char* bottom() const
+    {
+        return base + guard;
+    }
+
+    std::size_t size() const
+    {
+        return usable;
+    }
+
+private:
+    char*       base = nullptr;
+    std::size_t usable;
+    std::size_t guard;
+};
+
+class Scheduler
+{
+public:
+    static constexpr std::size_t STACK_SIZE = 1024 * 1024;
+
+    using Entry = std::function<void()>;
+    std::function<void(int)> onSuspend;   // task-ul cedeaza procesorul (nu si la terminare)
+    std::function<void(int)> onResume;    // task-ul porneste sau continua
+
+    Scheduler() = default;
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    // Task nou, gata de rulare; intoarce id-ul lui
+    int spawn(Entry entry)
+    {
+        auto task   = std::make_unique<Task>();
+        task->entry = std::move(entry);
+        task->stack  = std::make_unique<TaskStack>(STACK_SIZE);
+        getcontext(&task->context);
+        task->context.uc_stack.ss_sp   = task->stack->bottom();
+        task->context.uc_stack.ss_size = task->stack->size();
+        task->context.uc_link          = &schedulerContext; // la return din entry
+        makecontext(&task->context, &Scheduler::start, 0);
+
+        int id;
+        if (freeIds.empty())
+        {
+            id = static_cast<int>(tasks.size());
+            tasks.push_back(std::move(task));
+        }
+        else
+        {
+            id = freeIds.back();
+            freeIds.pop_back();
+            tasks[id] = std::move(task);
+        }
+        spawned++;
+        wake(id);
+        return id;
+    }
+
+    // Ruleaza pana nu mai e niciun task gata. false daca au ramas task-uri blocate.
+    // O exceptie aruncata intr-un task se arunca mai departe de aici.
+    bool run()
+    {
+        active = this;
+        while (!ready.empty())
+        {
+            int id = ready.front();
+            ready.pop_front();
+            Task& task  = *tasks[id];
+            task.queued = false;
+
+            current = id;
+            switches++;
+            if (onResume)
+                onResume(id);
+            void* fakeStack = nullptr;
+            startSwitch(&fakeStack, task.stack->bottom(), task.stack->size());
+            swapcontext(&schedulerContext, &task.context);
+            finishSwitch(fakeStack, nullptr, nullptr);
+            if (!task.done && onSuspend)
+                onSuspend(id);
+            current = -1;
+
+            if (task.done)
+            {
+                tasks[id].reset();
+                freeIds.push_back(id);
+                finished++;
+            }
+            if (failure)
+            {
+                std::exception_ptr error = failure;
+                reset();
+                std::rethrow_exception(error);
+            }
+        }
+        active = nullptr;
+        return finished == spawned;
+    }
+
+    // Task-ul curent asteapta pana il trezeste cineva cu wake()
+    void block()
+    {
+        Task& task = *tasks[current];
+        startSwitch(&task.fakeStack, schedulerBottom, schedulerSize);
+        swapcontext(&task.context, &schedulerContext);
+        finishSwitch(task.fakeStack, &schedulerBottom, &schedulerSize);
+    }
+
+    void wake(int id)
+    {
+        Task& task = *tasks[id];
+        if (task.done || task.queued)
+            return;
+        task.queued = true;
+        ready.push_back(id);
+    }
+
+    bool inTask() const
+    {
+        return current >= 0;
+    }
+
+    int currentTask() const
+    {
+        return current;
+    }
+
+    // Cel mai mic octet al stivei task-ului curent (nullptr in afara unui task)
+    const char* stackBottom() const
+    {
+        return current >= 0 ? tasks[current]->stack->bottom() : nullptr;
+    }
+
+    // Cate task-uri au fost pornite in total
+    std::size_t taskCount() const
+    {
+        return spawned;
+    }
+
+    // Marginea id-urilor folosite pana acum (id < slotCount())
+    std::size_t slotCount() const
+    {
+        return tasks.size();
+    }
+
+    std::size_t finishedCount() const
+    {
+        return finished;
+    }
+
+    std::size_t switchCount() const
+    {
+        return switches;
+    }
+
+    // Uita toate task-urile (dupa o eroare sau intre doua programe)
+    void reset()
+    {
+        tasks.clear();
+        freeIds.clear();
+        ready.clear();
+        failure  = nullptr;
+        current  = -1;
+        spawned  = 0;
+        finished = 0;
+        switches = 0;
+        active   = nullptr;
+    }
+
+private:
+    struct Task
+    {
+        Entry                   entry;
+        ucontext_t              context;
+        std::unique_ptr<TaskStack> stack;
+        bool                    queued = false;
+        bool                    done   = false;
+        void*                   fakeStack = nullptr;   // pt. ASan
+    };
+
+    static void startSwitch(void** fakeStack, const void* bottom, std::size_t size)
+    {
+#ifdef LFAC_ASAN_FIBERS
+        __sanitizer_start_switch_fiber(fakeStack, bottom, size);
+#else
+        (void)fakeStack, (void)bottom, (void)size;
+#endif
+    }
+
+    static void finishSwitch(void* fakeStack, const void** bottom, std::size_t* size)
+    {
+#ifdef LFAC_ASAN_FIBERS
+        __sanitizer_finish_switch_fiber(fakeStack, bottom, size);
+#else
+        (void)fakeStack, (void)bottom, (void)size;
+#endif
+    }
+
+    // Punctul de intrare al corutinei; makecontext nu transmite pointeri portabil,
+    // asa ca planificatorul activ sta intr-o variabila statica
+    static void start()
+    {
+        Scheduler& self = *active;
+        Task&      task = *self.tasks[self.current];
+        finishSwitch(nullptr, &self.schedulerBottom, &self.schedulerSize);
+        try
+        {
+            task.entry();
+        }
+        catch (...)
+        {
+            self.failure = std::current_exception();
+        }
+        task.done = true;
+        startSwitch(nullptr, self.schedulerBottom, self.schedulerSize);   // stiva task-ului nu mai revine
+    }   // uc_link: inapoi in run()
+
+    static inline Scheduler* active = nullptr;
+
+    std::vector<std::unique_ptr<Task>> tasks;      // nullptr = id liber
+    std::vector<int>   freeIds;
+    std::deque<int>    ready;
+    ucontext_t         schedulerContext;
+    const void*        schedulerBottom = nullptr;   // stiva lui run(), pt. ASan
+    std::size_t        schedulerSize   = 0;
+    int                current  = -1;
+    std::size_t        spawned  = 0;
+    std::size_t        finished = 0;
+    std::size_t        switches = 0;
+    std::exception_ptr failure;
+};